@@ -0,0 +1,208 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "bench.h"
+
+volatile int bench_sink;
+volatile int bench_zero;
+
+static const char *bench_prog   = "bench";
+static const char *bench_filter = NULL;
+static bool        bench_json   = false;
+static double      bench_min_ns = 2e7;
+
+static void
+usage(void) {
+    fprintf(stderr, "usage: %s [--json] [--quick] [--filter=SUBSTRING]\n", bench_prog);
+    exit(2);
+}
+
+void
+bench_init(int argc, char **argv) {
+    const char *p;
+    int i;
+
+    if (argc > 0 && argv[0]) {
+        p = strrchr(argv[0], '/');
+        bench_prog = p ? p + 1 : argv[0];
+    }
+
+    for (i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--json") == 0)
+            bench_json = true;
+        else if (strcmp(argv[i], "--quick") == 0)
+            bench_min_ns = 2e6;
+        else if (strncmp(argv[i], "--filter=", 9) == 0)
+            bench_filter = argv[i] + 9;
+        else
+            usage();
+    }
+}
+
+double
+bench_now(void) {
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+/*
+ * Names, variants and inputs are identifiers chosen by the benchmarks,
+ * so they are emitted without escaping.
+ */
+void
+bench_report(const char *name, const char *variant, const char *input,
+             size_t ops, double ns, double latency) {
+    if (bench_json) {
+        printf("{\"bench\":\"%s\",\"name\":\"%s\",\"variant\":\"%s\",\"input\":\"%s\","
+               "\"ops\":%lu,\"ns_per_op\":%.3f,\"mops_per_sec\":%.3f",
+               bench_prog, name, variant, input, (unsigned long)ops,
+               ns / (double)ops, (double)ops * 1e3 / ns);
+        if (latency >= 0)
+            printf(",\"latency_ns\":%.3f", latency);
+        printf("}\n");
+    }
+    else {
+        printf("%-32s %-10s %-12s %8.2f ns/op %10.2f Mop/s",
+               name, variant, input, ns / (double)ops, (double)ops * 1e3 / ns);
+        if (latency >= 0)
+            printf(" %8.2f ns latency", latency);
+        printf("\n");
+    }
+    fflush(stdout);
+}
+
+void
+bench_start(bench_t *b, const char *name, const char *variant, const char *input) {
+    memset(b, 0, sizeof(*b));
+    b->name    = name;
+    b->variant = variant;
+    b->input   = input;
+    b->skip    = (bench_filter && !strstr(name, bench_filter));
+}
+
+/*
+ * Doubles the number of rounds until a single measurement takes at least
+ * the minimum time; the earlier, shorter measurements serve as warm up.
+ */
+bool
+bench_round(bench_t *b, bench_mode_t mode) {
+    double elapsed;
+
+    if (b->skip)
+        return false;
+
+    if (b->rounds == 0) {
+        b->rounds = 1;
+        b->count  = 0;
+        b->start  = bench_now();
+    }
+
+    if (b->count < b->rounds) {
+        b->count++;
+        return true;
+    }
+
+    elapsed = bench_now() - b->start;
+    if (elapsed < bench_min_ns && b->rounds < ((size_t)1 << 30)) {
+        b->rounds *= 2;
+        b->count  = 1;
+        b->start  = bench_now();
+        return true;
+    }
+
+    b->ns[mode]  = elapsed;
+    b->ops[mode] = b->rounds * BENCH_N;
+    b->rounds    = 0;
+    return false;
+}
+
+void
+bench_finish(bench_t *b) {
+    if (b->skip)
+        return;
+    bench_report(b->name, b->variant, b->input,
+                 b->ops[BENCH_THROUGHPUT], b->ns[BENCH_THROUGHPUT],
+                 b->ns[BENCH_LATENCY] / (double)b->ops[BENCH_LATENCY]);
+}
+
+unsigned int
+bench_rand(unsigned int *state) {
+    *state = *state * 1103515245 + 12345;
+    return *state;
+}
+
+/*
+ * Fills dst with pseudo random dates drawn from one of the distributions:
+ *
+ *   modern      1970-01-01 to 2099-12-31
+ *   historical  1600-01-01 to 1899-12-31
+ *   full        0001-01-01 to 9999-12-31
+ *   extreme     any value of dt_t
+ */
+void
+bench_fill_dates(dt_t *dst, size_t n, const char *input) {
+    unsigned int state = 1;
+    unsigned int r;
+    size_t i;
+    dt_t first, last;
+
+    if (strcmp(input, "modern") == 0)
+        first = dt_from_ymd(1970, 1, 1), last = dt_from_ymd(2099, 12, 31);
+    else if (strcmp(input, "historical") == 0)
+        first = dt_from_ymd(1600, 1, 1), last = dt_from_ymd(1899, 12, 31);
+    else if (strcmp(input, "full") == 0)
+        first = dt_from_ymd(1, 1, 1), last = dt_from_ymd(9999, 12, 31);
+    else
+        first = last = 0;
+
+    for (i = 0; i < n; i++) {
+        r = bench_rand(&state) ^ (bench_rand(&state) >> 16);
+        if (first == last)
+            dst[i] = (dt_t)r;
+        else
+            dst[i] = first + (dt_t)(r % (unsigned int)(last - first + 1));
+    }
+}
+
+/*
+ * Fills dst, which has room for n dates, with a sorted holiday list and
+ * returns the number of holidays:
+ *
+ *   none          an empty list
+ *   realistic     six public holidays a year from 1970 to 2099
+ *   pathological  every weekday from 1970 to 2099 except the first
+ *                 weekday of each month
+ */
+size_t
+bench_fill_holidays(dt_t *dst, size_t n, const char *input) {
+    size_t count = 0;
+    dt_t dt, end, easter;
+    int y;
+
+#define PUSH(d) do { if (count < n) dst[count++] = (d); } while (0)
+
+    if (strcmp(input, "realistic") == 0) {
+        for (y = 1970; y <= 2099; y++) {
+            easter = dt_from_easter(y, DT_WESTERN);
+            PUSH(dt_from_ymd(y, 1, 1));
+            PUSH(easter - 2);
+            PUSH(easter + 1);
+            PUSH(dt_from_ymd(y, 5, 1));
+            PUSH(dt_from_ymd(y, 12, 25));
+            PUSH(dt_from_ymd(y, 12, 26));
+        }
+    }
+    else if (strcmp(input, "pathological") == 0) {
+        dt  = dt_from_ymd(1970, 1, 1);
+        end = dt_from_ymd(2099, 12, 31);
+        for (; dt <= end; dt++) {
+            if (dt_is_weekday(dt) && dt != dt_from_nth_weekday_in_month(dt_year(dt), dt_month(dt), 1))
+                PUSH(dt);
+        }
+    }
+#undef PUSH
+    return count;
+}
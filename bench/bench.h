@@ -0,0 +1,80 @@
+#ifndef __BENCH_H__
+#define __BENCH_H__
+
+#include <stddef.h>
+#include <stdbool.h>
+#include "dt.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Number of inputs per round; must be a power of two */
+#define BENCH_N 4096
+
+typedef enum {
+    BENCH_THROUGHPUT = 0,
+    BENCH_LATENCY
+} bench_mode_t;
+
+typedef struct {
+    const char *name;
+    const char *variant;
+    const char *input;
+    bool        skip;
+    size_t      rounds;
+    size_t      count;
+    double      start;
+    double      ns[2];
+    size_t      ops[2];
+} bench_t;
+
+void    bench_init      (int argc, char **argv);
+double  bench_now       (void);
+void    bench_report    (const char *name, const char *variant, const char *input,
+                         size_t ops, double ns, double latency);
+
+void    bench_start     (bench_t *b, const char *name, const char *variant, const char *input);
+bool    bench_round     (bench_t *b, bench_mode_t mode);
+void    bench_finish    (bench_t *b);
+
+unsigned int bench_rand (unsigned int *state);
+
+void    bench_fill_dates    (dt_t *dst, size_t n, const char *input);
+size_t  bench_fill_holidays (dt_t *dst, size_t n, const char *input);
+
+extern volatile int bench_sink;
+extern volatile int bench_zero;
+
+/*
+ * Evaluates EXPR for i in [0, BENCH_N) and reports both the throughput,
+ * where successive evaluations are independent, and the latency, where
+ * the index of the next input depends on the result of the previous
+ * evaluation. EXPR must yield a value convertible to int.
+ */
+#define BENCH(name, variant, input, expr)                               \
+    do {                                                                \
+        bench_t bench_;                                                 \
+        size_t i, bench_z_;                                             \
+        int bench_r_;                                                   \
+                                                                        \
+        bench_z_ = (size_t)bench_zero;                                  \
+        bench_r_ = 0;                                                   \
+        bench_start(&bench_, name, variant, input);                     \
+        while (bench_round(&bench_, BENCH_THROUGHPUT)) {                \
+            for (i = 0; i < BENCH_N; i++)                               \
+                bench_r_ += (int)(expr);                                \
+        }                                                               \
+        while (bench_round(&bench_, BENCH_LATENCY)) {                   \
+            for (i = 0; i < BENCH_N; i += 1 + ((size_t)bench_r_ & bench_z_)) \
+                bench_r_ = (int)(expr);                                 \
+        }                                                               \
+        bench_sink += bench_r_;                                         \
+        bench_finish(&bench_);                                          \
+    } while (0)
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,180 @@
+#include <time.h>
+#include "dt.h"
+#include "bench.h"
+
+#define VARIANT "default"
+#define CHUNK   64
+
+static dt_t dates[BENCH_N];
+static dt_t others[BENCH_N];
+static int  years[BENCH_N], months[BENCH_N], days[BENCH_N];
+static int  quarters[BENCH_N], qdays[BENCH_N];
+static int  weeks[BENCH_N], wdays[BENCH_N], ydays[BENCH_N];
+static int  deltas[BENCH_N];
+static int  out_y[BENCH_N], out_m[BENCH_N], out_d[BENCH_N];
+static dt_t out_dt[BENCH_N];
+static dt_timestamp_t stamps[BENCH_N];
+
+static void
+fill(const char *input) {
+    unsigned int state = 7;
+    size_t i;
+
+    bench_fill_dates(dates, BENCH_N, input);
+    for (i = 0; i < BENCH_N; i++) {
+        others[i] = dates[(i * 7 + 13) & (BENCH_N - 1)];
+        deltas[i] = (int)(bench_rand(&state) >> 16) % 241 - 120;
+        dt_to_ymd(dates[i], &years[i], &months[i], &days[i]);
+        dt_to_yqd(dates[i], &years[i], &quarters[i], &qdays[i]);
+        dt_to_yd(dates[i], &years[i], &ydays[i]);
+        dt_to_ywd(dates[i], &out_y[i], &weeks[i], &wdays[i]);
+        stamps[i] = dt_timestamp_from_dt(dates[i], (int)(bench_rand(&state) % 86400),
+                                         (int)(bench_rand(&state) % 1000000000));
+    }
+}
+
+static int
+tm_mday(dt_t dt) {
+    struct tm tm;
+
+    dt_to_struct_tm(dt, &tm);
+    return tm.tm_mday;
+}
+
+static void
+run(const char *input) {
+    dt_weekend_t wk;
+    int y, q, m, w, d;
+    int64_t sec;
+    int32_t nsec;
+
+    fill(input);
+    dt_weekend_init(&wk, DT_WEEKEND(DT_FRIDAY) | DT_WEEKEND(DT_SATURDAY));
+
+    /* dt_core.h */
+    BENCH("dt_from_yd", VARIANT, input, dt_from_yd(years[i], ydays[i]));
+    BENCH("dt_from_ymd", VARIANT, input, dt_from_ymd(years[i], months[i], days[i]));
+    BENCH("dt_from_yqd", VARIANT, input, dt_from_yqd(years[i], quarters[i], qdays[i]));
+    BENCH("dt_from_ywd", VARIANT, input, dt_from_ywd(out_y[i], weeks[i], wdays[i]));
+    BENCH("dt_to_yd", VARIANT, input,
+          (dt_to_yd(dates[i], &y, &d), y + d));
+    BENCH("dt_to_ymd", VARIANT, input,
+          (dt_to_ymd(dates[i], &y, &m, &d), y + m + d));
+    BENCH("dt_to_yqd", VARIANT, input,
+          (dt_to_yqd(dates[i], &y, &q, &d), y + q + d));
+    BENCH("dt_to_ywd", VARIANT, input,
+          (dt_to_ywd(dates[i], &y, &w, &d), y + w + d));
+    BENCH("dt_dow", VARIANT, input, dt_dow(dates[i]));
+
+    /* dt_accessor.h */
+    BENCH("dt_year", VARIANT, input, dt_year(dates[i]));
+    BENCH("dt_quarter", VARIANT, input, dt_quarter(dates[i]));
+    BENCH("dt_month", VARIANT, input, dt_month(dates[i]));
+    BENCH("dt_doy", VARIANT, input, dt_doy(dates[i]));
+    BENCH("dt_dom", VARIANT, input, dt_dom(dates[i]));
+    BENCH("dt_woy", VARIANT, input, dt_woy(dates[i]));
+
+    /* dt_util.h, dt_valid.h, dt_length.h */
+    BENCH("dt_leap_year", VARIANT, input, dt_leap_year(years[i]));
+    BENCH("dt_days_in_month", VARIANT, input, dt_days_in_month(years[i], months[i]));
+    BENCH("dt_weeks_in_year", VARIANT, input, dt_weeks_in_year(years[i]));
+    BENCH("dt_valid_ymd", VARIANT, input, dt_valid_ymd(years[i], months[i], days[i]));
+    BENCH("dt_length_of_month", VARIANT, input, dt_length_of_month(dates[i]));
+
+    /* dt_arithmetic.h */
+    BENCH("dt_add_years", VARIANT, input, dt_add_years(dates[i], deltas[i], DT_LIMIT));
+    BENCH("dt_add_months", VARIANT, input, dt_add_months(dates[i], deltas[i], DT_LIMIT));
+    BENCH("dt_add_quarters", VARIANT, input, dt_add_quarters(dates[i], deltas[i], DT_EXCESS));
+    BENCH("dt_delta_ymd", VARIANT, input,
+          (dt_delta_ymd(dates[i], others[i], &y, &m, &d), y + m + d));
+    BENCH("dt_delta_years", VARIANT, input, dt_delta_years(dates[i], others[i], true));
+    BENCH("dt_delta_months", VARIANT, input, dt_delta_months(dates[i], others[i], true));
+    BENCH("dt_delta_weeks", VARIANT, input, dt_delta_weeks(dates[i], others[i]));
+
+    /* dt_navigate.h */
+    BENCH("dt_start_of_month", VARIANT, input, dt_start_of_month(dates[i], 0));
+    BENCH("dt_end_of_month", VARIANT, input, dt_end_of_month(dates[i], 1));
+    BENCH("dt_end_of_quarter", VARIANT, input, dt_end_of_quarter(dates[i], 0));
+    BENCH("dt_start_of_year", VARIANT, input, dt_start_of_year(dates[i], 0));
+    BENCH("dt_start_of_week", VARIANT, input, dt_start_of_week(dates[i], DT_MONDAY));
+
+    /* dt_dow.h, dt_weekday.h */
+    BENCH("dt_next_dow", VARIANT, input, dt_next_dow(dates[i], DT_FRIDAY, false));
+    BENCH("dt_nth_dow_in_month", VARIANT, input, dt_nth_dow_in_month(dates[i], -1, DT_FRIDAY));
+    BENCH("dt_dow_in_month", VARIANT, input, dt_dow_in_month(dates[i], false));
+    BENCH("dt_add_weekdays", VARIANT, input, dt_add_weekdays(dates[i], deltas[i]));
+    BENCH("dt_delta_weekdays", VARIANT, input, dt_delta_weekdays(dates[i], others[i], true));
+    BENCH("dt_nth_weekday_in_month", VARIANT, input, dt_nth_weekday_in_month(dates[i], 3));
+    BENCH("dt_weekday_in_year", VARIANT, input, dt_weekday_in_year(dates[i], false));
+    BENCH("dt_weekend_next_weekday", VARIANT, input, dt_weekend_next_weekday(&wk, dates[i], false));
+    BENCH("dt_weekend_add_weekdays", VARIANT, input, dt_weekend_add_weekdays(&wk, dates[i], deltas[i]));
+    BENCH("dt_weekend_delta_weekdays", VARIANT, input,
+          dt_weekend_delta_weekdays(&wk, dates[i], others[i], true));
+
+    /* dt_easter.h, dt_tm.h */
+    BENCH("dt_from_easter", VARIANT, input, dt_from_easter(years[i], DT_WESTERN));
+    BENCH("dt_to_struct_tm", VARIANT, input, tm_mday(dates[i]));
+
+    /* dt_batch.h, reported per element */
+    BENCH("dt_to_ymd_n", VARIANT, input,
+          (i & (CHUNK - 1)) ? out_d[i] :
+          (dt_to_ymd_n(dates + i, CHUNK, out_y + i, out_m + i, out_d + i), out_d[i]));
+    BENCH("dt_from_ymd_n", VARIANT, input,
+          (i & (CHUNK - 1)) ? out_dt[i] :
+          (dt_from_ymd_n(years + i, months + i, days + i, CHUNK, out_dt + i), out_dt[i]));
+
+    /* dt64.h */
+    BENCH("dt64_from_ymd", VARIANT, input, (int)dt64_from_ymd(years[i], months[i], days[i]));
+    BENCH("dt64_to_ymd", VARIANT, input,
+          (dt64_to_ymd(dates[i], &y, &m, &d), y + m + d));
+    BENCH("dt64_add_months", VARIANT, input,
+          (int)dt64_add_months(dates[i], deltas[i], DT_LIMIT));
+    BENCH("dt64_delta_months", VARIANT, input,
+          (int)dt64_delta_months(dates[i], others[i], true));
+
+    /* dt_timestamp.h */
+    BENCH("dt_timestamp_from_dt", VARIANT, input,
+          (int)dt_timestamp_from_dt(dates[i], deltas[i] + 3600, 0).sec);
+    BENCH("dt_timestamp_to_dt", VARIANT, input,
+          (dt_timestamp_to_dt(stamps[i], &out_dt[0], &d, &m), out_dt[0] + d + m));
+    BENCH("dt_timestamp_add_nsec", VARIANT, input,
+          dt_timestamp_add_nsec(stamps[i], (int64_t)deltas[i] * 999999999).nsec);
+    BENCH("dt_timestamp_delta", VARIANT, input,
+          (dt_timestamp_delta(stamps[i], stamps[BENCH_N - 1 - i], &sec, &nsec), (int)sec + nsec));
+    BENCH("dt_timestamp_compare", VARIANT, input,
+          dt_timestamp_compare(stamps[i], stamps[BENCH_N - 1 - i]));
+}
+
+static int
+decode(dt_t dt) {
+    int y, m, d, w, wd;
+
+    dt_to_ymd(dt, &y, &m, &d);
+    dt_to_ywd(dt, &y, &w, &wd);
+    return m + d + w + wd + dt_doy(dt) + dt_quarter(dt);
+}
+
+/* Consecutive days from 2000-01-01, as a daily calendar or time series walks them */
+static void
+run_sequential(void) {
+    dt_cursor_t c;
+    size_t i;
+
+    for (i = 0; i < BENCH_N; i++)
+        dates[i] = dt_from_ymd(2000, 1, 1) + (dt_t)i;
+    dt_cursor_init(&c, dates[0]);
+
+    /* dt_cursor.h */
+    BENCH("dt_cursor_set", VARIANT, "sequential",
+          (dt_cursor_set(&c, dates[i]), c.month + c.day + c.week + c.dow + c.doy + c.quarter));
+    BENCH("dt_cursor_set", "decode", "sequential", decode(dates[i]));
+}
+
+int
+main(int argc, char **argv) {
+    bench_init(argc, argv);
+    run("modern");
+    run("full");
+    run_sequential();
+    return 0;
+}
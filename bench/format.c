@@ -0,0 +1,101 @@
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "dt.h"
+#include "bench.h"
+
+#define WIDTH   48
+#define PATTERN "%a, %d %b %Y %H:%M:%S"
+
+static dt_t dates[BENCH_N];
+static int  sods[BENCH_N], nsecs[BENCH_N], offsets[BENCH_N];
+static char buf[WIDTH];
+
+static void
+fill(const char *input) {
+    unsigned int state = 5;
+    size_t i;
+
+    bench_fill_dates(dates, BENCH_N, input);
+    for (i = 0; i < BENCH_N; i++) {
+        sods[i]    = (int)((bench_rand(&state) >> 8) % 86400);
+        nsecs[i]   = (int)(bench_rand(&state) % 1000000000);
+        offsets[i] = (int)((bench_rand(&state) >> 8) % 97) * 15 - 720;
+    }
+}
+
+static int
+snprintf_date(dt_t dt) {
+    int y, m, d;
+
+    dt_to_ymd(dt, &y, &m, &d);
+    return snprintf(buf, sizeof(buf), "%04d-%02d-%02d", y, m, d);
+}
+
+static int
+snprintf_datetime(dt_t dt, int sod, int nsec, int offset) {
+    int y, m, d;
+    char sign;
+
+    dt_to_ymd(dt, &y, &m, &d);
+    sign = offset < 0 ? '-' : '+';
+    if (offset < 0)
+        offset = -offset;
+    return snprintf(buf, sizeof(buf), "%04d-%02d-%02dT%02d:%02d:%02d.%03d%c%02d:%02d",
+                    y, m, d, sod / 3600, sod / 60 % 60, sod % 60, nsec / 1000000,
+                    sign, offset / 60, offset % 60);
+}
+
+/* The struct tm round trip that dt_format_pattern() avoids */
+static int
+strftime_pattern(dt_t dt, int sod) {
+    struct tm tm;
+
+    memset(&tm, 0, sizeof(tm));
+    dt_to_struct_tm(dt, &tm);
+    tm.tm_hour = sod / 3600;
+    tm.tm_min  = sod / 60 % 60;
+    tm.tm_sec  = sod % 60;
+    return (int)strftime(buf, sizeof(buf), PATTERN, &tm);
+}
+
+static void
+run(const char *input) {
+    dt_format_pattern_t pat;
+
+    dt_format_pattern_compile(&pat, PATTERN);
+    fill(input);
+
+    BENCH("dt_format_iso_date", "default", input,
+          dt_format_iso_date(buf, WIDTH, dates[i]) + buf[9]);
+    BENCH("dt_format_iso_date", "snprintf", input,
+          snprintf_date(dates[i]) + buf[9]);
+    BENCH("dt_format_iso_date_basic", "default", input,
+          dt_format_iso_date_basic(buf, WIDTH, dates[i]) + buf[7]);
+    BENCH("dt_format_iso_ordinal_date", "default", input,
+          dt_format_iso_ordinal_date(buf, WIDTH, dates[i]) + buf[7]);
+    BENCH("dt_format_iso_week_date", "default", input,
+          dt_format_iso_week_date(buf, WIDTH, dates[i]) + buf[9]);
+    BENCH("dt_format_iso_quarter_date", "default", input,
+          dt_format_iso_quarter_date(buf, WIDTH, dates[i]) + buf[9]);
+    BENCH("dt_format_iso_time", "default", input,
+          dt_format_iso_time(buf, WIDTH, sods[i], nsecs[i], 9) + buf[7]);
+    BENCH("dt_format_iso_zone", "default", input,
+          dt_format_iso_zone(buf, WIDTH, offsets[i]) + buf[0]);
+    BENCH("dt_format_iso_datetime", "default", input,
+          dt_format_iso_datetime(buf, WIDTH, dates[i], sods[i], nsecs[i], 3, offsets[i]) + buf[22]);
+    BENCH("dt_format_iso_datetime", "snprintf", input,
+          snprintf_datetime(dates[i], sods[i], nsecs[i], offsets[i]) + buf[22]);
+    BENCH("dt_format_pattern", "default", input,
+          (int)dt_format_pattern(&pat, buf, WIDTH, dates[i], sods[i], 0, 0) + buf[5]);
+    BENCH("dt_format_pattern", "strftime", input,
+          strftime_pattern(dates[i], sods[i]) + buf[5]);
+}
+
+int
+main(int argc, char **argv) {
+    bench_init(argc, argv);
+    run("modern");
+    run("full");
+    return 0;
+}
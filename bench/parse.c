@@ -0,0 +1,216 @@
+#define _XOPEN_SOURCE 700
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "dt.h"
+#include "bench.h"
+
+#define VARIANT "default"
+#define WIDTH   48
+#define PATTERN "%d/%b/%Y:%H:%M:%S %z"
+
+static char   strs[BENCH_N][WIDTH];
+static size_t lens[BENCH_N];
+static dt_t   dates[BENCH_N];
+
+static const char *month_names[] = {
+    "Jan", "Feb", "Mar", "Apr", "May", "Jun", "Jul", "Aug", "Sep", "Oct", "Nov", "Dec"
+};
+
+static const char *zone_names[] = {
+#define DT_ZONE_ENTRY(enc, offset, name, flags) name,
+#include "dt_zone_entries.h"
+#undef DT_ZONE_ENTRY
+};
+
+static const unsigned int zone_encs[] = {
+#define DT_ZONE_ENTRY(enc, offset, name, flags) enc,
+#include "dt_zone_entries.h"
+#undef DT_ZONE_ENTRY
+};
+
+#define ZONE_COUNT (sizeof(zone_names) / sizeof(*zone_names))
+
+/* The bisection over the sorted encodings that dt_zone_lookup() used before its hash */
+static size_t
+bisect_zone_lookup(const char *str, size_t len) {
+    const unsigned char *p = (const unsigned char *)str;
+    unsigned int enc;
+    size_t i, lo, hi, mid;
+
+    len = dt_char_span_alpha(p, len);
+    if (!len || len > 5)
+        return 0;
+
+    enc = 0;
+    for (i = 0; i < len; i++)
+        enc = (enc << 5) | ((p[i] | 0x20) ^ 0x60);
+
+    lo = 0;
+    hi = ZONE_COUNT - 1;
+    while (lo < hi) {
+        mid = (lo + hi) / 2;
+        if (zone_encs[mid] < enc)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    return zone_encs[lo] == enc ? len : 0;
+}
+
+/*
+ * Fills strs with strings of the given form. The "invalid" forms are
+ * adversarial: they look like canonical dates or timestamps but fail
+ * late, on an out of range field or a bad final character.
+ */
+static void
+fill(const char *form) {
+    unsigned int state = 3;
+    unsigned int r;
+    size_t i, n;
+    int sod, nsec, offset;
+    char *s;
+
+    bench_fill_dates(dates, BENCH_N, "modern");
+    for (i = 0; i < BENCH_N; i++) {
+        r      = bench_rand(&state) >> 8;
+        s      = strs[i];
+        sod    = (int)(r % 86400);
+        nsec   = (int)(bench_rand(&state) % 1000000000);
+        offset = (int)(r % 97) * 15 - 720;
+
+        if (strcmp(form, "date") == 0)
+            n = dt_format_iso_date(s, WIDTH, dates[i]);
+        else if (strcmp(form, "date_basic") == 0)
+            n = dt_format_iso_date_basic(s, WIDTH, dates[i]);
+        else if (strcmp(form, "week_date") == 0)
+            n = dt_format_iso_week_date(s, WIDTH, dates[i]);
+        else if (strcmp(form, "ordinal_date") == 0)
+            n = dt_format_iso_ordinal_date(s, WIDTH, dates[i]);
+        else if (strcmp(form, "date_invalid") == 0) {
+            n = dt_format_iso_date(s, WIDTH, dates[i]);
+            s[5 + (r & 1) * 3] = '4';
+        }
+        else if (strcmp(form, "time") == 0)
+            n = dt_format_iso_time(s, WIDTH, sod, nsec, (int)(r % 10));
+        else if (strcmp(form, "zone") == 0)
+            n = dt_format_iso_zone(s, WIDTH, offset);
+        else if (strcmp(form, "rfc3339") == 0)
+            n = dt_format_iso_datetime(s, WIDTH, dates[i], sod, nsec, (int)(r % 4) * 3, offset);
+        else if (strcmp(form, "datetime_basic") == 0) {
+            n  = dt_format_iso_date_basic(s, WIDTH, dates[i]);
+            s[n++] = 'T';
+            n += dt_format_iso_time_basic(s + n, WIDTH - n, sod, 0, 0);
+            n += dt_format_iso_zone_basic(s + n, WIDTH - n, offset);
+        }
+        else if (strcmp(form, "datetime_invalid") == 0) {
+            n = dt_format_iso_datetime(s, WIDTH, dates[i], sod, nsec, 3, offset);
+            s[n - 1] = 'x';
+        }
+        else if (strcmp(form, "log") == 0) {
+            int y, m, d;
+            dt_to_ymd(dates[i], &y, &m, &d);
+            n = (size_t)snprintf(s, WIDTH, "%02d/%s/%04d:%02d:%02d:%02d %+03d%02d",
+                                 d, month_names[m - 1], y, sod / 3600, sod / 60 % 60, sod % 60,
+                                 offset / 60, offset < 0 ? -offset % 60 : offset % 60);
+        }
+        else if (strcmp(form, "zone_name") == 0) {
+            strcpy(s, zone_names[r % ZONE_COUNT]);
+            n = strlen(s);
+        }
+        else { /* unknown zone names */
+            s[0] = 'Q';
+            s[1] = (char)('A' + r % 26);
+            s[2] = (char)('A' + r / 26 % 26);
+            s[3] = (char)('a' + r / 676 % 26);
+            n = 4;
+        }
+        lens[i] = n;
+    }
+}
+
+static void
+run_date(const char *form) {
+    dt_t dt;
+    dt64_t dt64;
+
+    dt = 0;
+    dt64 = 0;
+    fill(form);
+    BENCH("dt_parse_iso_date", VARIANT, form,
+          (int)dt_parse_iso_date(strs[i], lens[i], &dt) + dt);
+    BENCH("dt64_parse_iso_date", VARIANT, form,
+          (int)dt64_parse_iso_date(strs[i], lens[i], &dt64) + (int)dt64);
+}
+
+static void
+run_datetime(const char *form) {
+    dt_t dt;
+    int sod, nsec, offset;
+
+    sod = 0;
+    fill(form);
+    BENCH("dt_parse_iso_datetime", VARIANT, form,
+          (int)dt_parse_iso_datetime(strs[i], lens[i], &dt, &sod, &nsec, &offset) + sod);
+}
+
+/* A common log format timestamp, against strptime() with the same pattern */
+static void
+run_pattern(void) {
+    dt_parse_pattern_t pat;
+    struct tm tm;
+    dt_t dt;
+    int sod;
+
+    sod = 0;
+    memset(&tm, 0, sizeof(tm));
+    dt_parse_pattern_compile(&pat, PATTERN);
+    fill("log");
+    BENCH("dt_parse_pattern", VARIANT, "log",
+          (int)dt_parse_pattern(&pat, strs[i], lens[i], &dt, &sod, NULL, NULL) + sod);
+    BENCH("dt_parse_pattern", "strptime", "log",
+          (strptime(strs[i], PATTERN, &tm) != NULL) + tm.tm_sec);
+}
+
+int
+main(int argc, char **argv) {
+    int sod, nsec, offset;
+    const dt_zone_t *zone;
+
+    bench_init(argc, argv);
+    sod = offset = 0;
+
+    run_date("date");
+    run_date("date_basic");
+    run_date("week_date");
+    run_date("ordinal_date");
+    run_date("date_invalid");
+
+    run_datetime("rfc3339");
+    run_datetime("datetime_basic");
+    run_datetime("datetime_invalid");
+
+    run_pattern();
+
+    fill("time");
+    BENCH("dt_parse_iso_time", VARIANT, "time",
+          (int)dt_parse_iso_time(strs[i], lens[i], &sod, &nsec) + sod);
+
+    fill("zone");
+    BENCH("dt_parse_iso_zone", VARIANT, "zone",
+          (int)dt_parse_iso_zone(strs[i], lens[i], &offset) + offset);
+    BENCH("dt_parse_iso_zone_lenient", VARIANT, "zone",
+          (int)dt_parse_iso_zone_lenient(strs[i], lens[i], &offset) + offset);
+
+    fill("zone_name");
+    BENCH("dt_zone_lookup", VARIANT, "zone_name",
+          (int)dt_zone_lookup(strs[i], lens[i], &zone));
+    BENCH("dt_zone_lookup", "bisect", "zone_name",
+          (int)bisect_zone_lookup(strs[i], lens[i]));
+    fill("zone_unknown");
+    BENCH("dt_zone_lookup", VARIANT, "zone_unknown",
+          (int)dt_zone_lookup(strs[i], lens[i], &zone));
+    BENCH("dt_zone_lookup", "bisect", "zone_unknown",
+          (int)bisect_zone_lookup(strs[i], lens[i]));
+    return 0;
+}
@@ -0,0 +1,69 @@
+#include <stdlib.h>
+#include <string.h>
+#include "dt.h"
+#include "bench.h"
+
+#define VARIANT "default"
+
+static dt_t   keys[BENCH_N];
+static dt_t   sorted[BENCH_N];
+static size_t out[BENCH_N];
+
+static int
+compare_dt(const void *a, const void *b) {
+    dt_t x = *(const dt_t *)a, y = *(const dt_t *)b;
+
+    return (x > y) - (x < y);
+}
+
+/*
+ * Sorted dates, about two per day, searched for random keys within their
+ * range. The largest array is 40 MB, well beyond the last level cache.
+ */
+static void
+run(const char *input, size_t n) {
+    unsigned int state = 13;
+    dt_search_index_t *idx;
+    const dt_t *end;
+    dt_t *dates;
+    size_t i;
+
+    dates = (dt_t *)malloc(n * sizeof(dt_t));
+    if (!dates)
+        return;
+    dates[0] = 0;
+    for (i = 1; i < n; i++)
+        dates[i] = dates[i - 1] + (dt_t)((bench_rand(&state) >> 8) & 1);
+    for (i = 0; i < BENCH_N; i++)
+        keys[i] = (dt_t)((bench_rand(&state) >> 4) % (unsigned int)(dates[n - 1] + 1));
+    end = dates + n;
+    memcpy(sorted, keys, sizeof(keys));
+    qsort(sorted, BENCH_N, sizeof(dt_t), compare_dt);
+
+    idx = dt_search_index_new(dates, end);
+    BENCH("dt_lower_bound", VARIANT, input, (int)(dt_lower_bound(keys[i], dates, end) - dates));
+    BENCH("dt_lower_bound", "eytzinger", input, (int)dt_search_index_lower_bound(idx, keys[i]));
+    BENCH("dt_upper_bound", VARIANT, input, (int)(dt_upper_bound(keys[i], dates, end) - dates));
+    BENCH("dt_upper_bound", "eytzinger", input, (int)dt_search_index_upper_bound(idx, keys[i]));
+    BENCH("dt_binary_search", VARIANT, input, dt_binary_search(keys[i], dates, end));
+    BENCH("dt_binary_search", "eytzinger", input, dt_search_index_contains(idx, keys[i]));
+    dt_search_index_free(idx);
+
+    /* Sorted keys, dt_lower_bound_n() reported per element */
+    BENCH("dt_lower_bound", VARIANT "_sorted", input,
+          (int)(dt_lower_bound(sorted[i], dates, end) - dates));
+    BENCH("dt_lower_bound_n", VARIANT "_sorted", input,
+          (int)(i ? out[i] : (dt_lower_bound_n(sorted, BENCH_N, dates, end, out), out[0])));
+    free(dates);
+}
+
+int
+main(int argc, char **argv) {
+    bench_init(argc, argv);
+    run("16", 16);
+    run("40", 40);
+    run("1k", 1000);
+    run("100k", 100000);
+    run("10m", 10000000);
+    return 0;
+}
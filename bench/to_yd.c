@@ -0,0 +1,39 @@
+#include "dt.h"
+#include "bench.h"
+
+#if defined(DT_YMD_TABLE)
+#  define VARIANT "table"
+#elif defined(DT_EAF)
+#  define VARIANT "eaf"
+#elif defined(DT_NO_SHORTCUTS)
+#  define VARIANT "general"
+#else
+#  define VARIANT "shortcut"
+#endif
+
+static dt_t dates[BENCH_N];
+
+static void
+run(const char *input) {
+    int y, m, d;
+
+    bench_fill_dates(dates, BENCH_N, input);
+
+    BENCH("dt_to_yd", VARIANT, input,
+          (dt_to_yd(dates[i], &y, &d), y + d));
+    BENCH("dt_to_ymd", VARIANT, input,
+          (dt_to_ymd(dates[i], &y, &m, &d), y + m + d));
+#ifdef DT_EAF
+    BENCH("dt64_to_ymd", VARIANT, input,
+          (dt64_to_ymd(dates[i], &y, &m, &d), y + m + d));
+#endif
+}
+
+int
+main(int argc, char **argv) {
+    bench_init(argc, argv);
+    run("modern");
+    run("historical");
+    run("extreme");
+    return 0;
+}
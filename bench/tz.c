@@ -0,0 +1,92 @@
+#include <stdlib.h>
+#include <time.h>
+#include "dt.h"
+#include "bench.h"
+
+#define VARIANT "default"
+#define ZONE    "America/New_York"
+
+static int64_t stamps[BENCH_N];
+static int64_t locals[BENCH_N];
+static dt_t    dts[BENCH_N];
+static int     sods[BENCH_N];
+
+static int
+row_to_local(const dt_tz_t *tz, int64_t utc, dt_tz_interval_t *cache) {
+    dt_timestamp_t ts;
+    dt_t dt;
+    int sod;
+
+    ts.sec  = dt_tz_utc_to_local(tz, utc, cache);
+    ts.nsec = 0;
+    dt_timestamp_to_dt(ts, &dt, &sod, NULL);
+    return dt + sod;
+}
+
+/*
+ * Fills stamps with instants, either in ascending order five minutes apart
+ * from 2024-03-01, which crosses the transition on 2024-03-10, or at
+ * random from 1970 through 2099.
+ */
+static void
+fill(const char *input) {
+    unsigned int state = 17;
+    size_t i;
+
+    for (i = 0; i < BENCH_N; i++) {
+        if (input[0] == 's')
+            stamps[i] = 1709251200 + (int64_t)i * 60 * 5;
+        else
+            stamps[i] = (int64_t)(bench_rand(&state) ^ (bench_rand(&state) >> 16)) % 4102444800LL;
+    }
+}
+
+static int
+libc_offset(int64_t utc) {
+    struct tm tm;
+    time_t t;
+
+    t = (time_t)utc;
+    localtime_r(&t, &tm);
+    return (int)tm.tm_gmtoff;
+}
+
+static void
+run(dt_tz_t *tz, const char *input) {
+    dt_tz_interval_t cache;
+    size_t i;
+
+    fill(input);
+    cache.tz = NULL;
+    for (i = 0; i < BENCH_N; i++)
+        locals[i] = dt_tz_utc_to_local(tz, stamps[i], &cache);
+
+    BENCH("dt_tz_utc_to_local", VARIANT, input,
+          (int)(dt_tz_utc_to_local(tz, stamps[i], &cache) - stamps[i]));
+    BENCH("dt_tz_utc_to_local", "nocache", input,
+          (int)(dt_tz_utc_to_local(tz, stamps[i], NULL) - stamps[i]));
+    BENCH("dt_tz_utc_to_local", "localtime_r", input, libc_offset(stamps[i]));
+    BENCH("dt_tz_utc_to_local_n", "rows", input, row_to_local(tz, stamps[i], &cache));
+    BENCH("dt_tz_utc_to_local_n", VARIANT, input,
+          i ? dts[i] + sods[i] : (dt_tz_utc_to_local_n(tz, stamps, BENCH_N, dts, sods), dts[0]));
+    BENCH("dt_tz_local_to_utc", VARIANT, input,
+          (int)(dt_tz_local_to_utc(tz, locals[i], DT_TZ_EARLIER, &cache) - locals[i]));
+    BENCH("dt_tz_local_to_utc", "nocache", input,
+          (int)(dt_tz_local_to_utc(tz, locals[i], DT_TZ_EARLIER, NULL) - locals[i]));
+}
+
+int
+main(int argc, char **argv) {
+    dt_tz_t *tz;
+
+    bench_init(argc, argv);
+    tz = dt_tz_load(ZONE);
+    if (!tz)
+        return 0;
+    setenv("TZ", ":" ZONE, 1);
+    tzset();
+    run(tz, "sequential");
+    run(tz, "random");
+    dt_tz_free(tz);
+    return 0;
+}
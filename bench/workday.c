@@ -0,0 +1,85 @@
+#include "dt.h"
+#include "bench.h"
+
+#define VARIANT "default"
+#define MAX_HOLIDAYS 65536
+
+static dt_t dates[BENCH_N];
+static dt_t sorted[BENCH_N];
+static dt_t out[BENCH_N];
+static dt_t others[BENCH_N];
+static int  deltas[BENCH_N];
+static dt_t holidays[MAX_HOLIDAYS];
+
+static void
+run(const char *input) {
+    unsigned int state = 11;
+    dt_calendar_t *cal;
+    const dt_t *end;
+    size_t i, n;
+
+    n   = bench_fill_holidays(holidays, MAX_HOLIDAYS, input);
+    end = holidays + n;
+
+    bench_fill_dates(dates, BENCH_N, "modern");
+    for (i = 0; i < BENCH_N; i++) {
+        sorted[i] = dt_from_ymd(2000, 1, 1) + (dt_t)(i * 7 / 4);
+        others[i] = dates[i] + (dt_t)((bench_rand(&state) >> 8) % 731) - 365;
+        deltas[i] = (int)((bench_rand(&state) >> 8) % 521) - 260;
+    }
+
+    BENCH("dt_is_holiday", VARIANT, input, dt_is_holiday(dates[i], holidays, n));
+    BENCH("dt_is_workday", VARIANT, input, dt_is_workday(dates[i], holidays, n));
+    BENCH("dt_next_workday", VARIANT, input, dt_next_workday(dates[i], true, holidays, n));
+    BENCH("dt_prev_workday", VARIANT, input, dt_prev_workday(dates[i], false, holidays, n));
+    BENCH("dt_roll_workday", VARIANT, input,
+          dt_roll_workday(dates[i], DT_MODIFIED_FOLLOWING, holidays, n));
+    BENCH("dt_add_workdays", VARIANT, input, dt_add_workdays(dates[i], deltas[i], holidays, n));
+    BENCH("dt_delta_workdays", VARIANT, input,
+          dt_delta_workdays(dates[i], others[i], false, holidays, n));
+    BENCH("dt_nth_workday_in_month", VARIANT, input,
+          dt_nth_workday_in_month(dates[i], -1, holidays, n));
+
+    /* A sorted schedule, dt_*_n() reported per element */
+    BENCH("dt_roll_workday", VARIANT "_sorted", input,
+          dt_roll_workday(sorted[i], DT_MODIFIED_FOLLOWING, holidays, n));
+    BENCH("dt_roll_workday_n", VARIANT "_sorted", input,
+          i ? out[i] : (dt_roll_workday_n(sorted, BENCH_N, DT_MODIFIED_FOLLOWING,
+                                          holidays, n, out), out[0]));
+    BENCH("dt_add_workdays", VARIANT "_sorted", input, dt_add_workdays(sorted[i], 5, holidays, n));
+    BENCH("dt_add_workdays_n", VARIANT "_sorted", input,
+          i ? out[i] : (dt_add_workdays_n(sorted, BENCH_N, 5, holidays, n, out), out[0]));
+
+    cal = dt_calendar_new(dt_from_ymd(1970, 1, 1), dt_from_ymd(2099, 12, 31),
+                          DT_WEEKEND_DEFAULT, holidays, n);
+    BENCH("dt_calendar_is_workday", VARIANT, input, dt_calendar_is_workday(cal, dates[i]));
+    BENCH("dt_calendar_next_workday", VARIANT, input,
+          dt_calendar_next_workday(cal, dates[i], true));
+    BENCH("dt_calendar_prev_workday", VARIANT, input,
+          dt_calendar_prev_workday(cal, dates[i], false));
+    BENCH("dt_calendar_roll_workday", VARIANT, input,
+          dt_calendar_roll_workday(cal, dates[i], DT_MODIFIED_FOLLOWING));
+    BENCH("dt_calendar_add_workdays", VARIANT, input,
+          dt_calendar_add_workdays(cal, dates[i], deltas[i]));
+    BENCH("dt_calendar_delta_workdays", VARIANT, input,
+          dt_calendar_delta_workdays(cal, dates[i], others[i], false));
+    dt_calendar_free(cal);
+
+    if (n) {
+        BENCH("dt_lower_bound", VARIANT, input,
+              (int)(dt_lower_bound(dates[i], holidays, end) - holidays));
+        BENCH("dt_upper_bound", VARIANT, input,
+              (int)(dt_upper_bound(dates[i], holidays, end) - holidays));
+        BENCH("dt_binary_search", VARIANT, input,
+              dt_binary_search(dates[i], holidays, end));
+    }
+}
+
+int
+main(int argc, char **argv) {
+    bench_init(argc, argv);
+    run("none");
+    run("realistic");
+    run("pathological");
+    return 0;
+}
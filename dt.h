@@ -25,17 +25,27 @@
  */
 #ifndef __DT_H__
 #define __DT_H__
+#include "dt64.h"
 #include "dt_accessor.h"
 #include "dt_arithmetic.h"
+#include "dt_batch.h"
+#include "dt_calendar.h"
 #include "dt_char.h"
 #include "dt_core.h"
+#include "dt_cursor.h"
 #include "dt_dow.h"
 #include "dt_easter.h"
+#include "dt_format_iso.h"
+#include "dt_format_pattern.h"
+#include "dt_holiday.h"
 #include "dt_length.h"
 #include "dt_navigate.h"
 #include "dt_parse_iso.h"
+#include "dt_parse_pattern.h"
 #include "dt_search.h"
+#include "dt_timestamp.h"
 #include "dt_tm.h"
+#include "dt_tz.h"
 #include "dt_util.h"
 #include "dt_valid.h"
 #include "dt_weekday.h"
@@ -0,0 +1,352 @@
+/*
+ * Copyright (c) 2012-2015 Christian Hansen <chansen@cpan.org>
+ * <https://github.com/chansen/c-dt>
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met: 
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer. 
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution. 
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <assert.h>
+#include "dt64.h"
+#include "dt_kernel.h"
+#include "dt_util.h"
+
+static const int days_preceding_month[2][13] = {
+    { 0, 0, 31, 59, 90, 120, 151, 181, 212, 243, 273, 304, 334 },
+    { 0, 0, 31, 60, 91, 121, 152, 182, 213, 244, 274, 305, 335 }
+};
+
+static const int days_preceding_quarter[2][5] = {
+    { 0, 0, 90, 181, 273 },
+    { 0, 0, 91, 182, 274 }
+};
+
+dt64_t
+dt64_from_dt(dt_t dt) {
+    return dt;
+}
+
+bool
+dt64_to_dt(dt64_t dt, dt_t *dtp) {
+    if (dt < INT32_MIN || dt > INT32_MAX)
+        return false;
+    if (dtp)
+        *dtp = (dt_t)dt;
+    return true;
+}
+
+dt64_t
+dt64_from_rdn(int64_t n) {
+    return n + DT_EPOCH_OFFSET;
+}
+
+/*
+ * The year arithmetic is done in 64 bits, so that a normalized or shifted
+ * year beyond the range of an int, and a day of the year beyond the range
+ * of an int after adding the days of the preceding months, cannot overflow.
+ */
+static bool
+leap_year(int64_t y) {
+    return (y % 4 == 0) && (y % 100 != 0 || y % 400 == 0);
+}
+
+static int
+days_in_year(int64_t y) {
+    return 365 + leap_year(y);
+}
+
+static int
+days_in_quarter(int64_t y, int q) {
+    const int l = leap_year(y);
+    return q < 4 ? days_preceding_quarter[l][q + 1] - days_preceding_quarter[l][q] : 92;
+}
+
+static int
+days_in_month(int64_t y, int m) {
+    const int l = leap_year(y);
+    return m < 12 ? days_preceding_month[l][m + 1] - days_preceding_month[l][m] : 31;
+}
+
+static dt64_t
+from_yd(int64_t y, int64_t d) {
+    return dt_kernel_rdn_from_yd(y, d) + DT_EPOCH_OFFSET;
+}
+
+static dt64_t
+from_ymd(int64_t y, int64_t m, int64_t d) {
+    if (m < 1 || m > 12) {
+        y += m / 12;
+        m %= 12;
+        if (m < 1)
+            y--, m += 12;
+    }
+    assert(m >=  1);
+    assert(m <= 12);
+    return from_yd(y, days_preceding_month[leap_year(y)][m] + d);
+}
+
+static dt64_t
+from_yqd(int64_t y, int64_t q, int64_t d) {
+    if (q < 1 || q > 4) {
+        y += q / 4;
+        q %= 4;
+        if (q < 1)
+            y--, q += 4;
+    }
+    assert(q >= 1);
+    assert(q <= 4);
+    return from_yd(y, days_preceding_quarter[leap_year(y)][q] + d);
+}
+
+dt64_t
+dt64_from_yd(int y, int d) {
+    return from_yd(y, d);
+}
+
+dt64_t
+dt64_from_ymd(int y, int m, int d) {
+    return from_ymd(y, m, d);
+}
+
+dt64_t
+dt64_from_yqd(int y, int q, int d) {
+    return from_yqd(y, q, d);
+}
+
+dt64_t
+dt64_from_ywd(int y, int w, int d) {
+    dt64_t dt;
+
+    dt  = dt64_from_yd(y, 4);
+    dt -= dt64_dow(dt);
+    dt += (int64_t)w * 7 + d - 7;
+    return dt;
+}
+
+void
+dt64_to_yd(dt64_t dt, int *yp, int *dp) {
+    int64_t y;
+    int n, l;
+
+    dt_kernel_decompose(dt - DT_EPOCH_OFFSET, &y, &n, &l);
+    dt_kernel_to_yd(y, n, l, yp, dp);
+}
+
+void
+dt64_to_ymd(dt64_t dt, int *yp, int *mp, int *dp) {
+    int64_t y;
+    int n, l;
+
+    dt_kernel_decompose(dt - DT_EPOCH_OFFSET, &y, &n, &l);
+    dt_kernel_to_ymd(y, n, yp, mp, dp);
+}
+
+void
+dt64_to_yqd(dt64_t dt, int *yp, int *qp, int *dp) {
+    int64_t cy;
+    int y, n, l, doy, q;
+
+    dt_kernel_decompose(dt - DT_EPOCH_OFFSET, &cy, &n, &l);
+    dt_kernel_to_yd(cy, n, l, &y, &doy);
+    q = doy < 91 ? 1 : 1 + (5 * (doy - 59 - l) + 303) / 459;
+
+    assert(q >= 1);
+    assert(q <= 4);
+
+    if (yp) *yp = y;
+    if (qp) *qp = q;
+    if (dp) *dp = doy - days_preceding_quarter[l][q];
+}
+
+void
+dt64_to_ywd(dt64_t dt, int *yp, int *wp, int *dp) {
+    int64_t y;
+    int cy, doy, dow;
+
+    dt64_to_yd(dt, &cy, &doy);
+    dow = dt64_dow(dt);
+    doy = doy + 4 - dow;
+    y = cy;
+    if (doy < 1) {
+        y--;
+        doy += days_in_year(y);
+    }
+    else if (doy > 365) {
+        const int diy = days_in_year(y);
+        if (doy > diy) {
+            doy -= diy;
+            y++;
+        }
+    }
+    /* The week-based year of the first and last days of the range may not fit */
+    if (y < INT32_MIN)
+        y = INT32_MIN;
+    else if (y > INT32_MAX)
+        y = INT32_MAX;
+    if (yp) *yp = (int)y;
+    if (wp) *wp = (doy + 6) / 7;
+    if (dp) *dp = dow;
+}
+
+int64_t
+dt64_rdn(dt64_t dt) {
+    return dt - DT_EPOCH_OFFSET;
+}
+
+dt_dow_t
+dt64_dow(dt64_t dt) {
+    int dow;
+
+    dow = (int)((dt - DT_EPOCH_OFFSET) % 7);
+    if (dow < 1)
+        dow += 7;
+    assert(dow >= 1);
+    assert(dow <= 7);
+    return dow;
+}
+
+dt64_t
+dt64_add_years(dt64_t dt, int delta, dt_adjust_t adjust) {
+    int y, d;
+
+    dt64_to_yd(dt, &y, &d);
+    if (adjust == DT_EXCESS || d < 365)
+        return from_yd((int64_t)y + delta, d);
+    else {
+        int64_t ry = (int64_t)y + delta;
+        int diy;
+
+        diy = days_in_year(ry);
+        if (d > diy || (adjust == DT_SNAP && d == dt_days_in_year(y)))
+            d = diy;
+        return from_yd(ry, d);
+    }
+}
+
+dt64_t
+dt64_add_quarters(dt64_t dt, int delta, dt_adjust_t adjust) {
+    int y, q, d;
+
+    dt64_to_yqd(dt, &y, &q, &d);
+    if (adjust == DT_EXCESS || d < 90)
+        return from_yqd((int64_t)y + delta / 4, q + delta % 4, d);
+    else {
+        int64_t ry = (int64_t)y + delta / 4;
+        int rq = q + delta % 4;
+        int diq;
+
+        if (rq < 1 || rq > 4) {
+            ry += rq / 4;
+            rq %= 4;
+            if (rq < 1)
+                ry--, rq += 4;
+        }
+
+        diq = days_in_quarter(ry, rq);
+        if (d > diq || (adjust == DT_SNAP && d == dt_days_in_quarter(y, q)))
+            d = diq;
+        return from_yqd(ry, rq, d);
+    }
+}
+
+dt64_t
+dt64_add_months(dt64_t dt, int delta, dt_adjust_t adjust) {
+    int y, m, d;
+
+    dt64_to_ymd(dt, &y, &m, &d);
+    if (adjust == DT_EXCESS || d < 28)
+        return from_ymd((int64_t)y + delta / 12, m + delta % 12, d);
+    else {
+        int64_t ry = (int64_t)y + delta / 12;
+        int rm = m + delta % 12;
+        int dim;
+
+        if (rm < 1 || rm > 12) {
+            ry += rm / 12;
+            rm %= 12;
+            if (rm < 1)
+                ry--, rm += 12;
+        }
+
+        dim = days_in_month(ry, rm);
+        if (d > dim || (adjust == DT_SNAP && d == dt_days_in_month(y, m)))
+            d = dim;
+        return from_ymd(ry, rm, d);
+    }
+}
+
+int64_t
+dt64_delta_years(dt64_t dt1, dt64_t dt2, bool complete) {
+    int y1, y2, d1, d2;
+    int64_t years;
+
+    dt64_to_yd(dt1, &y1, &d1);
+    dt64_to_yd(dt2, &y2, &d2);
+
+    years = (int64_t)y2 - y1;
+    if (complete) {
+        if (dt1 > dt2)
+            years += (d2 > d1);
+        else
+            years -= (d1 > d2);
+    }
+    return years;
+}
+
+int64_t
+dt64_delta_quarters(dt64_t dt1, dt64_t dt2, bool complete) {
+    int y1, y2, q1, q2, d1, d2;
+    int64_t quarters;
+
+    dt64_to_yqd(dt1, &y1, &q1, &d1);
+    dt64_to_yqd(dt2, &y2, &q2, &d2);
+
+    quarters = 4 * ((int64_t)y2 - y1) + q2 - q1;
+    if (complete) {
+        if (dt1 > dt2)
+            quarters += (d2 > d1);
+        else
+            quarters -= (d1 > d2);
+    }
+    return quarters;
+}
+
+int64_t
+dt64_delta_months(dt64_t dt1, dt64_t dt2, bool complete) {
+    int y1, y2, m1, m2, d1, d2;
+    int64_t months;
+
+    dt64_to_ymd(dt1, &y1, &m1, &d1);
+    dt64_to_ymd(dt2, &y2, &m2, &d2);
+
+    months = 12 * ((int64_t)y2 - y1) + m2 - m1;
+    if (complete) {
+        if (dt1 > dt2)
+            months += (d2 > d1);
+        else
+            months -= (d1 > d2);
+    }
+    return months;
+}
+
+int64_t
+dt64_delta_weeks(dt64_t dt1, dt64_t dt2) {
+    return (dt2 - dt1) / 7;
+}
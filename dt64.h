@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) 2012-2015 Christian Hansen <chansen@cpan.org>
+ * <https://github.com/chansen/c-dt>
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met: 
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer. 
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution. 
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef __DT64_H__
+#define __DT64_H__
+#include <stdint.h>
+#include "dt_core.h"
+#include "dt_arithmetic.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef int64_t dt64_t;
+
+dt64_t   dt64_from_dt            (dt_t dt);
+bool     dt64_to_dt              (dt64_t dt, dt_t *dtp);
+
+dt64_t   dt64_from_rdn           (int64_t n);
+dt64_t   dt64_from_yd            (int y, int d);
+dt64_t   dt64_from_ymd           (int y, int m, int d);
+dt64_t   dt64_from_yqd           (int y, int q, int d);
+dt64_t   dt64_from_ywd           (int y, int w, int d);
+
+void     dt64_to_yd              (dt64_t dt, int *y, int *d);
+void     dt64_to_ymd             (dt64_t dt, int *y, int *m, int *d);
+void     dt64_to_yqd             (dt64_t dt, int *y, int *q, int *d);
+void     dt64_to_ywd             (dt64_t dt, int *y, int *w, int *d);
+
+int64_t  dt64_rdn                (dt64_t dt);
+dt_dow_t dt64_dow                (dt64_t dt);
+
+dt64_t   dt64_add_years          (dt64_t dt, int delta, dt_adjust_t adjust);
+dt64_t   dt64_add_quarters       (dt64_t dt, int delta, dt_adjust_t adjust);
+dt64_t   dt64_add_months         (dt64_t dt, int delta, dt_adjust_t adjust);
+
+int64_t  dt64_delta_years        (dt64_t start, dt64_t end, bool complete);
+int64_t  dt64_delta_quarters     (dt64_t start, dt64_t end, bool complete);
+int64_t  dt64_delta_months       (dt64_t start, dt64_t end, bool complete);
+int64_t  dt64_delta_weeks        (dt64_t start, dt64_t end);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -26,6 +26,18 @@
 #include <stddef.h>
 #include "dt_core.h"
 
+#ifdef DT_YMD_TABLE
+#  include "dt_ymd_table.h"
+#  define ENTRY_QUARTER(e) ((DT_YMD_ENTRY_MONTH(e) + 2) / 3)
+#  define TABLE_GET(dt, field)                                          \
+    do {                                                                \
+        if (DT_YMD_TABLE_INDEX(dt) < DT_YMD_TABLE_SIZE)                 \
+            return field(dt_ymd_table[DT_YMD_TABLE_INDEX(dt)]);         \
+    } while (0)
+#else
+#  define TABLE_GET(dt, field)
+#endif
+
 dt_t
 dt_from_cjdn(int n) {
     return dt_from_rdn(n - 1721425);
@@ -39,6 +51,7 @@ dt_cjdn(dt_t dt) {
 int
 dt_year(dt_t dt) {
     int y;
+    TABLE_GET(dt, DT_YMD_ENTRY_YEAR);
     dt_to_yd(dt, &y, NULL);
     return y;
 }
@@ -46,6 +59,7 @@ dt_year(dt_t dt) {
 int
 dt_quarter(dt_t dt) {
     int q;
+    TABLE_GET(dt, ENTRY_QUARTER);
     dt_to_yqd(dt, NULL, &q, NULL);
     return q;
 }
@@ -53,6 +67,7 @@ dt_quarter(dt_t dt) {
 int
 dt_month(dt_t dt) {
     int m;
+    TABLE_GET(dt, DT_YMD_ENTRY_MONTH);
     dt_to_ymd(dt, NULL, &m, NULL);
     return m;
 }
@@ -60,6 +75,7 @@ dt_month(dt_t dt) {
 int
 dt_doy(dt_t dt) {
     int d;
+    TABLE_GET(dt, DT_YMD_ENTRY_DOY);
     dt_to_yd(dt, NULL, &d);
     return d;
 }
@@ -74,6 +90,7 @@ dt_doq(dt_t dt) {
 int
 dt_dom(dt_t dt) {
     int d;
+    TABLE_GET(dt, DT_YMD_ENTRY_DAY);
     dt_to_ymd(dt, NULL, NULL, &d);
     return d;
 }
@@ -0,0 +1,375 @@
+/*
+ * Copyright (c) 2012-2015 Christian Hansen <chansen@cpan.org>
+ * <https://github.com/chansen/c-dt>
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met: 
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer. 
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution. 
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <stddef.h>
+#include "dt_core.h"
+#include "dt_batch.h"
+#include "dt_simd.h"
+
+/*
+ * The vector kernels use the Euclidean affine decomposition of Neri and
+ * Schneider on the computational calendar, which starts on March 1 of
+ * year 0 so that the leap day falls at the end of the year. Dates are
+ * shifted by BATCH_K cycles of 400 years to make them non-negative, this
+ * keeps every intermediate value within 32 bits as long as the shifted
+ * day number is below 2^30, i.e. approximately +/- 1.47 million years
+ * around the epoch. Lanes outside this window are converted using the
+ * scalar functions.
+ */
+#define BATCH_K     3674
+#define BATCH_LO    (DT_EPOCH_OFFSET - 305 - BATCH_K * 146097)
+
+/*
+ * The constructors shift the year by BATCH_Y cycles of 400 years, which
+ * makes every year above INT_MIN non-negative when treated as an unsigned
+ * 32-bit integer. The lanes are computed modulo 2^32, so the result equals
+ * that of the scalar functions for every date that is representable by a
+ * dt_t. Dates outside of the range of dt_t are outside of the domain of
+ * the scalar functions as well, the lanes wrap around instead.
+ */
+#define BATCH_Y     5368710u
+#define BATCH_YMIN  (-2147483647)
+#define BATCH_YMAX  (2147483647 - 400)
+
+#ifdef DT_SIMD_SSE2
+static __m128i
+mullo_epi32(__m128i a, __m128i b) {
+    const __m128i even = _mm_mul_epu32(a, b);
+    const __m128i odd  = _mm_mul_epu32(_mm_srli_si128(a, 4), _mm_srli_si128(b, 4));
+    return _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)),
+                              _mm_shuffle_epi32(odd,  _MM_SHUFFLE(0, 0, 2, 0)));
+}
+
+/* (a * b) >> k, for unsigned lanes and 32 <= k < 64 */
+static __m128i
+mulshr_epu32(__m128i a, __m128i b, int k) {
+    const __m128i n = _mm_cvtsi32_si128(k);
+    const __m128i even = _mm_srl_epi64(_mm_mul_epu32(a, b), n);
+    const __m128i odd  = _mm_srl_epi64(_mm_mul_epu32(_mm_srli_epi64(a, 32), b), n);
+    return _mm_or_si128(even, _mm_slli_epi64(odd, 32));
+}
+
+/*
+ * Converts four dates, returns a bit mask of the lanes that are outside
+ * the window of the kernel.
+ */
+static int
+to_ymd_sse2(__m128i dt, __m128i *yp, __m128i *mp, __m128i *dp) {
+    __m128i s, n1, c, nc, n2, z, ny, n3, y, m, d, j;
+
+    s  = _mm_sub_epi32(dt, _mm_set1_epi32(BATCH_LO));
+    n1 = _mm_add_epi32(_mm_slli_epi32(s, 2), _mm_set1_epi32(3));
+    c  = mulshr_epu32(n1, _mm_set1_epi32(963315389), 47);
+    nc = _mm_srli_epi32(_mm_sub_epi32(n1, mullo_epi32(c, _mm_set1_epi32(146097))), 2);
+    n2 = _mm_or_si128(_mm_slli_epi32(nc, 2), _mm_set1_epi32(3));
+    z  = mulshr_epu32(n2, _mm_set1_epi32(2939745), 32);
+    ny = _mm_sub_epi32(nc, _mm_srli_epi32(mullo_epi32(z, _mm_set1_epi32(1461)), 2));
+    y  = _mm_add_epi32(mullo_epi32(c, _mm_set1_epi32(100)), z);
+    n3 = _mm_add_epi32(mullo_epi32(ny, _mm_set1_epi32(2141)), _mm_set1_epi32(197913));
+    m  = _mm_srli_epi32(n3, 16);
+    d  = _mm_and_si128(n3, _mm_set1_epi32(0xFFFF));
+    d  = _mm_srli_epi32(_mm_mulhi_epu16(d, _mm_set1_epi32(31345)), 10);
+    j  = _mm_cmpgt_epi32(ny, _mm_set1_epi32(305));
+
+    *yp = _mm_sub_epi32(_mm_sub_epi32(y, _mm_set1_epi32(400 * BATCH_K)), j);
+    *mp = _mm_sub_epi32(m, _mm_and_si128(j, _mm_set1_epi32(12)));
+    *dp = _mm_add_epi32(d, _mm_set1_epi32(1));
+
+    s = _mm_cmpeq_epi32(_mm_srli_epi32(s, 30), _mm_setzero_si128());
+    return ~_mm_movemask_ps(_mm_castsi128_ps(s)) & 0xF;
+}
+
+static __m128i
+from_yd_sse2(__m128i y, __m128i d) {
+    __m128i u, c, dt;
+
+    u  = _mm_add_epi32(y, _mm_set1_epi32((int)(400 * BATCH_Y - 1)));
+    c  = mulshr_epu32(u, _mm_set1_epi32(1374389535), 37);
+    dt = mullo_epi32(u, _mm_set1_epi32(365));
+    dt = _mm_add_epi32(dt, _mm_srli_epi32(u, 2));
+    dt = _mm_sub_epi32(dt, c);
+    dt = _mm_add_epi32(dt, _mm_srli_epi32(c, 2));
+    dt = _mm_add_epi32(dt, d);
+    return _mm_add_epi32(dt, _mm_set1_epi32((int)(DT_EPOCH_OFFSET - 146097 * BATCH_Y)));
+}
+
+/* Returns -1 in the lanes of leap years, otherwise 0 */
+static __m128i
+leap_year_sse2(__m128i y) {
+    __m128i u, c, r, l;
+
+    u = _mm_add_epi32(y, _mm_set1_epi32((int)(400 * BATCH_Y)));
+    c = mulshr_epu32(u, _mm_set1_epi32(1374389535), 37);
+    r = _mm_sub_epi32(u, mullo_epi32(c, _mm_set1_epi32(100)));
+    l = _mm_or_si128(_mm_and_si128(r, _mm_set1_epi32(3)),
+                     _mm_and_si128(_mm_cmpeq_epi32(r, _mm_setzero_si128()),
+                                   _mm_and_si128(c, _mm_set1_epi32(3))));
+    return _mm_cmpeq_epi32(l, _mm_setzero_si128());
+}
+
+/* Returns a bit mask of the lanes with years outside the supported range */
+static int
+bad_years_sse2(__m128i y) {
+    const __m128i good = _mm_and_si128(_mm_cmpgt_epi32(y, _mm_set1_epi32(BATCH_YMIN - 1)),
+                                       _mm_cmpgt_epi32(_mm_set1_epi32(BATCH_YMAX + 1), y));
+    return ~_mm_movemask_ps(_mm_castsi128_ps(good)) & 0xF;
+}
+
+/* Returns a bit mask of the lanes with months that requires normalisation */
+static int
+bad_months_sse2(__m128i m) {
+    const __m128i good = _mm_and_si128(_mm_cmpgt_epi32(m, _mm_setzero_si128()),
+                                       _mm_cmpgt_epi32(_mm_set1_epi32(13), m));
+    return ~_mm_movemask_ps(_mm_castsi128_ps(good)) & 0xF;
+}
+
+static __m128i
+from_ymd_sse2(__m128i y, __m128i m, __m128i d) {
+    __m128i p, a;
+
+    /* Days preceding the month in a common year, (367m - 362)/12 - (m > 2 ? 2 : 0) */
+    p = _mm_sub_epi32(mullo_epi32(m, _mm_set1_epi32(367)), _mm_set1_epi32(362));
+    p = _mm_srli_epi32(mullo_epi32(p, _mm_set1_epi32(2731)), 15);
+    a = _mm_cmpgt_epi32(m, _mm_set1_epi32(2));
+    a = _mm_and_si128(a, _mm_add_epi32(_mm_set1_epi32(2), leap_year_sse2(y)));
+    return from_yd_sse2(y, _mm_add_epi32(d, _mm_sub_epi32(p, a)));
+}
+#endif
+
+#ifdef DT_SIMD_AVX2
+/* (a * b) >> k, for unsigned lanes and 32 <= k < 64 */
+static __m256i
+mulshr_epu32_avx2(__m256i a, __m256i b, int k) {
+    const __m128i n = _mm_cvtsi32_si128(k);
+    const __m256i even = _mm256_srl_epi64(_mm256_mul_epu32(a, b), n);
+    const __m256i odd  = _mm256_srl_epi64(_mm256_mul_epu32(_mm256_srli_epi64(a, 32), b), n);
+    return _mm256_or_si256(even, _mm256_slli_epi64(odd, 32));
+}
+
+static int
+to_ymd_avx2(__m256i dt, __m256i *yp, __m256i *mp, __m256i *dp) {
+    __m256i s, n1, c, nc, n2, z, ny, n3, y, m, d, j;
+
+    s  = _mm256_sub_epi32(dt, _mm256_set1_epi32(BATCH_LO));
+    n1 = _mm256_add_epi32(_mm256_slli_epi32(s, 2), _mm256_set1_epi32(3));
+    c  = mulshr_epu32_avx2(n1, _mm256_set1_epi32(963315389), 47);
+    nc = _mm256_srli_epi32(_mm256_sub_epi32(n1, _mm256_mullo_epi32(c, _mm256_set1_epi32(146097))), 2);
+    n2 = _mm256_or_si256(_mm256_slli_epi32(nc, 2), _mm256_set1_epi32(3));
+    z  = mulshr_epu32_avx2(n2, _mm256_set1_epi32(2939745), 32);
+    ny = _mm256_sub_epi32(nc, _mm256_srli_epi32(_mm256_mullo_epi32(z, _mm256_set1_epi32(1461)), 2));
+    y  = _mm256_add_epi32(_mm256_mullo_epi32(c, _mm256_set1_epi32(100)), z);
+    n3 = _mm256_add_epi32(_mm256_mullo_epi32(ny, _mm256_set1_epi32(2141)), _mm256_set1_epi32(197913));
+    m  = _mm256_srli_epi32(n3, 16);
+    d  = _mm256_and_si256(n3, _mm256_set1_epi32(0xFFFF));
+    d  = _mm256_srli_epi32(_mm256_mulhi_epu16(d, _mm256_set1_epi32(31345)), 10);
+    j  = _mm256_cmpgt_epi32(ny, _mm256_set1_epi32(305));
+
+    *yp = _mm256_sub_epi32(_mm256_sub_epi32(y, _mm256_set1_epi32(400 * BATCH_K)), j);
+    *mp = _mm256_sub_epi32(m, _mm256_and_si256(j, _mm256_set1_epi32(12)));
+    *dp = _mm256_add_epi32(d, _mm256_set1_epi32(1));
+
+    s = _mm256_cmpeq_epi32(_mm256_srli_epi32(s, 30), _mm256_setzero_si256());
+    return ~_mm256_movemask_ps(_mm256_castsi256_ps(s)) & 0xFF;
+}
+
+static __m256i
+from_yd_avx2(__m256i y, __m256i d) {
+    __m256i u, c, dt;
+
+    u  = _mm256_add_epi32(y, _mm256_set1_epi32((int)(400 * BATCH_Y - 1)));
+    c  = mulshr_epu32_avx2(u, _mm256_set1_epi32(1374389535), 37);
+    dt = _mm256_mullo_epi32(u, _mm256_set1_epi32(365));
+    dt = _mm256_add_epi32(dt, _mm256_srli_epi32(u, 2));
+    dt = _mm256_sub_epi32(dt, c);
+    dt = _mm256_add_epi32(dt, _mm256_srli_epi32(c, 2));
+    dt = _mm256_add_epi32(dt, d);
+    return _mm256_add_epi32(dt, _mm256_set1_epi32((int)(DT_EPOCH_OFFSET - 146097 * BATCH_Y)));
+}
+
+static __m256i
+leap_year_avx2(__m256i y) {
+    __m256i u, c, r, l;
+
+    u = _mm256_add_epi32(y, _mm256_set1_epi32((int)(400 * BATCH_Y)));
+    c = mulshr_epu32_avx2(u, _mm256_set1_epi32(1374389535), 37);
+    r = _mm256_sub_epi32(u, _mm256_mullo_epi32(c, _mm256_set1_epi32(100)));
+    l = _mm256_or_si256(_mm256_and_si256(r, _mm256_set1_epi32(3)),
+                        _mm256_and_si256(_mm256_cmpeq_epi32(r, _mm256_setzero_si256()),
+                                         _mm256_and_si256(c, _mm256_set1_epi32(3))));
+    return _mm256_cmpeq_epi32(l, _mm256_setzero_si256());
+}
+
+static int
+bad_years_avx2(__m256i y) {
+    const __m256i good = _mm256_and_si256(_mm256_cmpgt_epi32(y, _mm256_set1_epi32(BATCH_YMIN - 1)),
+                                          _mm256_cmpgt_epi32(_mm256_set1_epi32(BATCH_YMAX + 1), y));
+    return ~_mm256_movemask_ps(_mm256_castsi256_ps(good)) & 0xFF;
+}
+
+static int
+bad_months_avx2(__m256i m) {
+    const __m256i good = _mm256_and_si256(_mm256_cmpgt_epi32(m, _mm256_setzero_si256()),
+                                          _mm256_cmpgt_epi32(_mm256_set1_epi32(13), m));
+    return ~_mm256_movemask_ps(_mm256_castsi256_ps(good)) & 0xFF;
+}
+
+static __m256i
+from_ymd_avx2(__m256i y, __m256i m, __m256i d) {
+    __m256i p, a;
+
+    p = _mm256_sub_epi32(_mm256_mullo_epi32(m, _mm256_set1_epi32(367)), _mm256_set1_epi32(362));
+    p = _mm256_srli_epi32(_mm256_mullo_epi32(p, _mm256_set1_epi32(2731)), 15);
+    a = _mm256_cmpgt_epi32(m, _mm256_set1_epi32(2));
+    a = _mm256_and_si256(a, _mm256_add_epi32(_mm256_set1_epi32(2), leap_year_avx2(y)));
+    return from_yd_avx2(y, _mm256_add_epi32(d, _mm256_sub_epi32(p, a)));
+}
+#endif
+
+#ifdef DT_SIMD_SSE2
+static void
+to_ymd_lanes(const dt_t *src, size_t i, int bad, int *yp, int *mp, int *dp) {
+    for (; bad; bad >>= 1, i++) {
+        if (bad & 1)
+            dt_to_ymd(src[i], yp ? yp + i : NULL, mp ? mp + i : NULL, dp ? dp + i : NULL);
+    }
+}
+#endif
+
+void
+dt_to_ymd_n(const dt_t *src, size_t n, int *yp, int *mp, int *dp) {
+    size_t i;
+
+    i = 0;
+#ifdef DT_SIMD_AVX2
+    for (; i + 8 <= n; i += 8) {
+        __m256i y, m, d;
+        int bad;
+
+        bad = to_ymd_avx2(_mm256_loadu_si256((const __m256i *)(src + i)), &y, &m, &d);
+        if (yp) _mm256_storeu_si256((__m256i *)(yp + i), y);
+        if (mp) _mm256_storeu_si256((__m256i *)(mp + i), m);
+        if (dp) _mm256_storeu_si256((__m256i *)(dp + i), d);
+        if (bad)
+            to_ymd_lanes(src, i, bad, yp, mp, dp);
+    }
+#endif
+#ifdef DT_SIMD_SSE2
+    for (; i + 4 <= n; i += 4) {
+        __m128i y, m, d;
+        int bad;
+
+        bad = to_ymd_sse2(_mm_loadu_si128((const __m128i *)(src + i)), &y, &m, &d);
+        if (yp) _mm_storeu_si128((__m128i *)(yp + i), y);
+        if (mp) _mm_storeu_si128((__m128i *)(mp + i), m);
+        if (dp) _mm_storeu_si128((__m128i *)(dp + i), d);
+        if (bad)
+            to_ymd_lanes(src, i, bad, yp, mp, dp);
+    }
+#endif
+    for (; i < n; i++)
+        dt_to_ymd(src[i], yp ? yp + i : NULL, mp ? mp + i : NULL, dp ? dp + i : NULL);
+}
+
+#ifdef DT_SIMD_SSE2
+static void
+from_yd_lanes(const int *y, const int *d, size_t i, int bad, dt_t *dst) {
+    for (; bad; bad >>= 1, i++) {
+        if (bad & 1)
+            dst[i] = dt_from_yd(y[i], d[i]);
+    }
+}
+
+static void
+from_ymd_lanes(const int *y, const int *m, const int *d, size_t i, int bad, dt_t *dst) {
+    for (; bad; bad >>= 1, i++) {
+        if (bad & 1)
+            dst[i] = dt_from_ymd(y[i], m[i], d[i]);
+    }
+}
+#endif
+
+void
+dt_from_yd_n(const int *y, const int *d, size_t n, dt_t *dst) {
+    size_t i;
+
+    i = 0;
+#ifdef DT_SIMD_AVX2
+    for (; i + 8 <= n; i += 8) {
+        const __m256i yv = _mm256_loadu_si256((const __m256i *)(y + i));
+        const __m256i dv = _mm256_loadu_si256((const __m256i *)(d + i));
+        int bad;
+
+        _mm256_storeu_si256((__m256i *)(dst + i), from_yd_avx2(yv, dv));
+        if ((bad = bad_years_avx2(yv)))
+            from_yd_lanes(y, d, i, bad, dst);
+    }
+#endif
+#ifdef DT_SIMD_SSE2
+    for (; i + 4 <= n; i += 4) {
+        const __m128i yv = _mm_loadu_si128((const __m128i *)(y + i));
+        const __m128i dv = _mm_loadu_si128((const __m128i *)(d + i));
+        int bad;
+
+        _mm_storeu_si128((__m128i *)(dst + i), from_yd_sse2(yv, dv));
+        if ((bad = bad_years_sse2(yv)))
+            from_yd_lanes(y, d, i, bad, dst);
+    }
+#endif
+    for (; i < n; i++)
+        dst[i] = dt_from_yd(y[i], d[i]);
+}
+
+void
+dt_from_ymd_n(const int *y, const int *m, const int *d, size_t n, dt_t *dst) {
+    size_t i;
+
+    i = 0;
+#ifdef DT_SIMD_AVX2
+    for (; i + 8 <= n; i += 8) {
+        const __m256i yv = _mm256_loadu_si256((const __m256i *)(y + i));
+        const __m256i mv = _mm256_loadu_si256((const __m256i *)(m + i));
+        const __m256i dv = _mm256_loadu_si256((const __m256i *)(d + i));
+        int bad;
+
+        _mm256_storeu_si256((__m256i *)(dst + i), from_ymd_avx2(yv, mv, dv));
+        if ((bad = bad_years_avx2(yv) | bad_months_avx2(mv)))
+            from_ymd_lanes(y, m, d, i, bad, dst);
+    }
+#endif
+#ifdef DT_SIMD_SSE2
+    for (; i + 4 <= n; i += 4) {
+        const __m128i yv = _mm_loadu_si128((const __m128i *)(y + i));
+        const __m128i mv = _mm_loadu_si128((const __m128i *)(m + i));
+        const __m128i dv = _mm_loadu_si128((const __m128i *)(d + i));
+        int bad;
+
+        _mm_storeu_si128((__m128i *)(dst + i), from_ymd_sse2(yv, mv, dv));
+        if ((bad = bad_years_sse2(yv) | bad_months_sse2(mv)))
+            from_ymd_lanes(y, m, d, i, bad, dst);
+    }
+#endif
+    for (; i < n; i++)
+        dst[i] = dt_from_ymd(y[i], m[i], d[i]);
+}
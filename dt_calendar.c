@@ -0,0 +1,583 @@
+/*
+ * Copyright (c) 2012-2015 Christian Hansen <chansen@cpan.org>
+ * <https://github.com/chansen/c-dt>
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met: 
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer. 
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution. 
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "dt_core.h"
+#include "dt_search.h"
+#include "dt_weekday.h"
+#include "dt_workday.h"
+#include "dt_calendar.h"
+
+/*
+ * A calendar holds a bitmap with one bit per day in [first, last], set
+ * for each workday, so that queries within the span are bit operations.
+ * ranks[w] is the number of workdays in the words before word w, which
+ * turns counting workdays into a rank query (a lookup and a popcount)
+ * and adding workdays into a select query. Queries outside the span fall
+ * back to the sorted holiday list, which only keeps holidays that fall
+ * on a workday of the week.
+ */
+struct dt_calendar {
+    dt_t         first;
+    dt_t         last;
+    dt_weekend_t wk;
+    size_t       n;
+    dt_t        *holidays;
+    size_t       nwords;
+    uint64_t    *bits;
+    uint32_t    *ranks;
+};
+
+/*
+ * Without a popcount instruction __builtin_popcountll() is a library
+ * call, which is slower than the inline bit twiddling below.
+ */
+#if defined(__GNUC__) && defined(__POPCNT__)
+#  define popcount64(x) __builtin_popcountll(x)
+#else
+static int
+popcount64(uint64_t x) {
+    x = x - ((x >> 1) & UINT64_C(0x5555555555555555));
+    x = (x & UINT64_C(0x3333333333333333)) + ((x >> 2) & UINT64_C(0x3333333333333333));
+    x = (x + (x >> 4)) & UINT64_C(0x0F0F0F0F0F0F0F0F);
+    return (int)((x * UINT64_C(0x0101010101010101)) >> 56);
+}
+#endif
+
+#if defined(__GNUC__)
+#  define ctz64(x) __builtin_ctzll(x)
+#  define clz64(x) __builtin_clzll(x)
+#else
+
+static int
+ctz64(uint64_t x) {
+    int n = 0;
+    while (!(x & 1)) {
+        x >>= 1;
+        n++;
+    }
+    return n;
+}
+
+static int
+clz64(uint64_t x) {
+    int n = 0;
+    while (!(x & UINT64_C(0x8000000000000000))) {
+        x <<= 1;
+        n++;
+    }
+    return n;
+}
+#endif
+
+/* Position of the j-th (zero based) set bit of x, which has more than j bits set */
+static int
+select64(uint64_t x, int j) {
+    int pos, c;
+
+    pos = 0;
+    c = popcount64(x & UINT64_C(0xFFFFFFFF));
+    if (j >= c) {
+        j -= c;
+        x >>= 32;
+        pos += 32;
+    }
+    c = popcount64(x & 0xFFFF);
+    if (j >= c) {
+        j -= c;
+        x >>= 16;
+        pos += 16;
+    }
+    c = popcount64(x & 0xFF);
+    if (j >= c) {
+        j -= c;
+        x >>= 8;
+        pos += 8;
+    }
+    for (; j; j--)
+        x &= x - 1;
+    return pos + ctz64(x);
+}
+
+static int
+compare_dt(const void *a, const void *b) {
+    const dt_t x = *(const dt_t *)a;
+    const dt_t y = *(const dt_t *)b;
+    return (x > y) - (x < y);
+}
+
+#define MIN(x, y) (((x) < (y)) ? (x) : (y))
+#define MAX(x, y) (((x) > (y)) ? (x) : (y))
+
+/*
+ * The list functions mirror dt_is_workday() and friends in dt_workday.c
+ * with the weekday tables of the calendar in place of the built-in ones.
+ */
+
+static bool
+list_is_workday(const dt_calendar_t *cal, dt_t dt) {
+    return dt_weekend_is_weekday(&cal->wk, dt) && !dt_is_holiday(dt, cal->holidays, cal->n);
+}
+
+static dt_t
+list_next_workday(const dt_calendar_t *cal, dt_t dt, bool current) {
+    dt = dt_weekend_next_weekday(&cal->wk, dt, current);
+    while (dt_is_holiday(dt, cal->holidays, cal->n))
+        dt = dt_weekend_next_weekday(&cal->wk, dt, false);
+    return dt;
+}
+
+static dt_t
+list_prev_workday(const dt_calendar_t *cal, dt_t dt, bool current) {
+    dt = dt_weekend_prev_weekday(&cal->wk, dt, current);
+    while (dt_is_holiday(dt, cal->holidays, cal->n))
+        dt = dt_weekend_prev_weekday(&cal->wk, dt, false);
+    return dt;
+}
+
+static dt_t
+list_add_workdays(const dt_calendar_t *cal, dt_t dt, int delta) {
+    const dt_t *holidays, *end, *lo, *up;
+
+    if (!cal->n)
+        return dt_weekend_add_weekdays(&cal->wk, dt, delta);
+
+    holidays = cal->holidays;
+    end = holidays + cal->n;
+
+    if (delta > 0) {
+        lo = dt_lower_bound(dt + 1, holidays, end);
+        do {
+            dt = dt_weekend_add_weekdays(&cal->wk, dt, delta);
+            up = dt_upper_bound(dt, lo, MIN(lo + delta, end));
+            delta = up - lo;
+            if (delta)
+                lo = dt_lower_bound(dt, up, MIN(up + delta, end));
+        } while (delta);
+    }
+    else if (delta < 0) {
+        up = dt_upper_bound(dt - 1, holidays, end);
+        do {
+            dt = dt_weekend_add_weekdays(&cal->wk, dt, delta);
+            lo = dt_lower_bound(dt, MAX(up + delta, holidays), up);
+            delta = lo - up;
+            if (delta)
+                up = dt_upper_bound(dt, MAX(lo + delta, holidays), lo);
+        } while (delta);
+    }
+    return dt;
+}
+
+/* Number of workdays in [start, end], where start <= end */
+static int
+list_count_workdays(const dt_calendar_t *cal, dt_t start, dt_t end) {
+    const dt_t *holidays;
+
+    if (!cal->n)
+        return dt_weekend_delta_weekdays(&cal->wk, start, end, true);
+    holidays = cal->holidays;
+    return dt_weekend_delta_weekdays(&cal->wk, start, end, true)
+         - (int)(dt_upper_bound(end, holidays, holidays + cal->n)
+               - dt_lower_bound(start, holidays, holidays + cal->n));
+}
+
+/* Number of workdays in [first, first + k), where k <= 64 * nwords */
+static uint32_t
+workday_rank(const dt_calendar_t *cal, size_t k) {
+    const size_t w = k >> 6;
+
+    if (!(k & 63))
+        return cal->ranks[w];
+    return cal->ranks[w] + popcount64(cal->bits[w] & ((UINT64_C(1) << (k & 63)) - 1));
+}
+
+/*
+ * Offset from first of the workday with the given zero based rank, which
+ * must be less than the number of workdays in the span. The word holding
+ * it is the last word w with ranks[w] <= r; the search gallops out from
+ * the word hint, so the cost grows with the logarithm of the distance.
+ */
+static size_t
+workday_select(const dt_calendar_t *cal, uint32_t r, size_t hint) {
+    const uint32_t *ranks = cal->ranks;
+    size_t lo, hi, mid, step;
+
+    if (ranks[hint] <= r) {
+        lo = hint;
+        hi = hint + 1;
+        for (step = 2; hi < cal->nwords && ranks[hi] <= r; step <<= 1) {
+            lo = hi;
+            hi = lo + step;
+        }
+        if (hi > cal->nwords)
+            hi = cal->nwords;
+    }
+    else {
+        hi = hint;
+        lo = hint - 1;
+        for (step = 2; ranks[lo] > r; step <<= 1) {
+            hi = lo;
+            lo = (hi > step) ? hi - step : 0;
+        }
+    }
+
+    while (hi - lo > 1) {
+        mid = lo + (hi - lo) / 2;
+        if (ranks[mid] <= r)
+            lo = mid;
+        else
+            hi = mid;
+    }
+    return lo * 64 + select64(cal->bits[lo], (int)(r - ranks[lo]));
+}
+
+dt_calendar_t *
+dt_calendar_new(dt_t first, dt_t last, unsigned int weekend, const dt_t *holidays, size_t n) {
+    dt_calendar_t *cal;
+    size_t i, j, k;
+    dt_t dt;
+
+    if (first > last)
+        return NULL;
+
+    cal = (dt_calendar_t *)calloc(1, sizeof(*cal));
+    if (!cal)
+        return NULL;
+    if (!dt_weekend_init(&cal->wk, weekend)) {
+        free(cal);
+        return NULL;
+    }
+
+    cal->first   = first;
+    cal->last    = last;
+    cal->nwords  = (((size_t)((unsigned int)last - (unsigned int)first)) >> 6) + 1;
+    cal->bits    = (uint64_t *)calloc(cal->nwords, sizeof(uint64_t));
+    cal->ranks   = (uint32_t *)malloc((cal->nwords + 1) * sizeof(uint32_t));
+    if (n)
+        cal->holidays = (dt_t *)malloc(n * sizeof(dt_t));
+
+    if (!cal->bits || !cal->ranks || (n && !cal->holidays)) {
+        dt_calendar_free(cal);
+        return NULL;
+    }
+
+    if (n) {
+        memcpy(cal->holidays, holidays, n * sizeof(dt_t));
+        qsort(cal->holidays, n, sizeof(dt_t), compare_dt);
+        for (i = 0, j = 0; i < n; i++) {
+            dt = cal->holidays[i];
+            if ((j && dt == cal->holidays[j - 1]) || !dt_weekend_is_weekday(&cal->wk, dt))
+                continue;
+            cal->holidays[j++] = dt;
+        }
+        n = j;
+    }
+    cal->n = n;
+
+    for (dt = first, k = 0;; dt++, k++) {
+        if (dt_weekend_is_weekday(&cal->wk, dt))
+            cal->bits[k >> 6] |= UINT64_C(1) << (k & 63);
+        if (dt == last)
+            break;
+    }
+
+    for (i = 0; i < n; i++) {
+        dt = cal->holidays[i];
+        if (dt < first || dt > last)
+            continue;
+        k = (size_t)((unsigned int)dt - (unsigned int)first);
+        cal->bits[k >> 6] &= ~(UINT64_C(1) << (k & 63));
+    }
+
+    cal->ranks[0] = 0;
+    for (k = 0; k < cal->nwords; k++)
+        cal->ranks[k + 1] = cal->ranks[k] + (uint32_t)popcount64(cal->bits[k]);
+    return cal;
+}
+
+void
+dt_calendar_free(dt_calendar_t *cal) {
+    if (!cal)
+        return;
+    free(cal->holidays);
+    free(cal->bits);
+    free(cal->ranks);
+    free(cal);
+}
+
+bool
+dt_calendar_is_workday(const dt_calendar_t *cal, dt_t dt) {
+    size_t k;
+
+    if (dt < cal->first || dt > cal->last)
+        return list_is_workday(cal, dt);
+    k = (size_t)((unsigned int)dt - (unsigned int)cal->first);
+    return (cal->bits[k >> 6] >> (k & 63)) & 1;
+}
+
+dt_t
+dt_calendar_next_workday(const dt_calendar_t *cal, dt_t dt, bool current) {
+    uint64_t word;
+    size_t k, w;
+
+    if (!current)
+        dt++;
+    if (dt < cal->first || dt > cal->last)
+        return list_next_workday(cal, dt, true);
+
+    k = (size_t)((unsigned int)dt - (unsigned int)cal->first);
+    w = k >> 6;
+    word = cal->bits[w] & (~UINT64_C(0) << (k & 63));
+    while (!word) {
+        if (++w == cal->nwords)
+            return list_next_workday(cal, cal->last, false);
+        word = cal->bits[w];
+    }
+    return cal->first + (dt_t)(w * 64 + ctz64(word));
+}
+
+dt_t
+dt_calendar_prev_workday(const dt_calendar_t *cal, dt_t dt, bool current) {
+    uint64_t word;
+    size_t k, w;
+
+    if (!current)
+        dt--;
+    if (dt < cal->first || dt > cal->last)
+        return list_prev_workday(cal, dt, true);
+
+    k = (size_t)((unsigned int)dt - (unsigned int)cal->first);
+    w = k >> 6;
+    word = cal->bits[w] & (~UINT64_C(0) >> (63 - (k & 63)));
+    while (!word) {
+        if (w-- == 0)
+            return list_prev_workday(cal, cal->first, false);
+        word = cal->bits[w];
+    }
+    return cal->first + (dt_t)(w * 64 + 63 - clz64(word));
+}
+
+dt_t
+dt_calendar_roll_workday(const dt_calendar_t *cal, dt_t dt, dt_bdc_t convention) {
+    dt_t start;
+    int y, m;
+
+    start = dt;
+    switch (convention) {
+        case DT_UNADJUSTED:
+            break;
+        case DT_FOLLOWING:
+            dt = dt_calendar_next_workday(cal, dt, true);
+            break;
+        case DT_MODIFIED_FOLLOWING:
+            dt = dt_calendar_next_workday(cal, dt, true);
+            if (dt != start) {
+                dt_to_ymd(start, &y, &m, NULL);
+                if (dt > dt_from_ymd(y, m + 1, 0))
+                    dt = dt_calendar_prev_workday(cal, start, false);
+            }
+            break;
+        case DT_PRECEDING:
+            dt = dt_calendar_prev_workday(cal, dt, true);
+            break;
+        case DT_MODIFIED_PRECEDING:
+            dt = dt_calendar_prev_workday(cal, dt, true);
+            if (dt != start) {
+                dt_to_ymd(start, &y, &m, NULL);
+                if (dt < dt_from_ymd(y, m, 1))
+                    dt = dt_calendar_next_workday(cal, start, false);
+            }
+            break;
+    }
+    return dt;
+}
+
+dt_t
+dt_calendar_add_workdays(const dt_calendar_t *cal, dt_t dt, int delta) {
+    int64_t r;
+    size_t k;
+
+    if (!delta)
+        return dt;
+    if (dt < cal->first || dt > cal->last)
+        return list_add_workdays(cal, dt, delta);
+
+    k = (size_t)((unsigned int)dt - (unsigned int)cal->first);
+    if (delta > 0)
+        r = (int64_t)workday_rank(cal, k + 1) + delta - 1;
+    else
+        r = (int64_t)workday_rank(cal, k) + delta;
+
+    if (r < 0 || r >= (int64_t)cal->ranks[cal->nwords])
+        return list_add_workdays(cal, dt, delta);
+    return cal->first + (dt_t)workday_select(cal, (uint32_t)r, k >> 6);
+}
+
+/*
+ * As with dt_delta_weekdays(), the exclusive count leaves out the
+ * earlier date if it is a workday, and otherwise the later date.
+ */
+int
+dt_calendar_delta_workdays(const dt_calendar_t *cal, dt_t start, dt_t end, bool inclusive) {
+    size_t k1, k2;
+    dt_t lo, hi;
+    int count;
+
+    lo = start < end ? start : end;
+    hi = start < end ? end : start;
+    if (lo < cal->first || hi > cal->last)
+        count = list_count_workdays(cal, lo, hi);
+    else {
+        k1 = (size_t)((unsigned int)lo - (unsigned int)cal->first);
+        k2 = (size_t)((unsigned int)hi - (unsigned int)cal->first);
+        count = (int)(workday_rank(cal, k2 + 1) - workday_rank(cal, k1));
+    }
+    if (!inclusive && (dt_calendar_is_workday(cal, lo) || dt_calendar_is_workday(cal, hi)))
+        count--;
+    return start <= end ? count : -count;
+}
+
+/*
+ * A joint calendar is an ordinary calendar whose weekend mask and holiday
+ * list reproduce the combination exactly, so it answers every query at
+ * the cost of a single calendar, within its span and outside it. The
+ * span is the smallest one that covers both components.
+ */
+dt_calendar_t *
+dt_calendar_join(const dt_calendar_t *a, const dt_calendar_t *b, dt_join_t how) {
+    dt_calendar_t *cal;
+    dt_weekend_t wk;
+    unsigned int mask;
+    dt_t *holidays;
+    dt_t dt;
+    size_t i, j, n;
+
+    if (how == DT_JOIN_ALL)
+        mask = a->wk.mask | b->wk.mask;
+    else if (how == DT_JOIN_ANY)
+        mask = a->wk.mask & b->wk.mask;
+    else
+        return NULL;
+    if (!dt_weekend_init(&wk, mask))
+        return NULL;
+
+    holidays = (dt_t *)malloc((a->n + b->n + 1) * sizeof(dt_t));
+    if (!holidays)
+        return NULL;
+
+    /* Merge the sorted lists, keeping the days that are not workdays */
+    for (i = 0, j = 0, n = 0; i < a->n || j < b->n;) {
+        if (j == b->n || (i < a->n && a->holidays[i] < b->holidays[j]))
+            dt = a->holidays[i++];
+        else if (i == a->n || b->holidays[j] < a->holidays[i])
+            dt = b->holidays[j++];
+        else {
+            dt = a->holidays[i++];
+            j++;
+        }
+        if (!dt_weekend_is_weekday(&wk, dt))
+            continue;
+        if (how == DT_JOIN_ANY && (list_is_workday(a, dt) || list_is_workday(b, dt)))
+            continue;
+        holidays[n++] = dt;
+    }
+
+    cal = dt_calendar_new(MIN(a->first, b->first), MAX(a->last, b->last), mask, holidays, n);
+    free(holidays);
+    return cal;
+}
+
+typedef struct {
+    const dt_calendar_t *a;
+    const dt_calendar_t *b;
+    dt_join_t            how;
+    dt_calendar_t       *cal;
+} join_t;
+
+struct dt_calendar_cache {
+    size_t  n;
+    size_t  size;
+    join_t *joins;
+};
+
+dt_calendar_cache_t *
+dt_calendar_cache_new(void) {
+    return (dt_calendar_cache_t *)calloc(1, sizeof(dt_calendar_cache_t));
+}
+
+void
+dt_calendar_cache_free(dt_calendar_cache_t *cache) {
+    size_t i;
+
+    if (!cache)
+        return;
+    for (i = 0; i < cache->n; i++)
+        dt_calendar_free(cache->joins[i].cal);
+    free(cache->joins);
+    free(cache);
+}
+
+/*
+ * Joins are keyed by the addresses of the components, in either order
+ * since both kinds of join are symmetric. A cache rarely holds more than
+ * a handful of joins, so a linear search is enough.
+ */
+const dt_calendar_t *
+dt_calendar_cache_join(dt_calendar_cache_t *cache, const dt_calendar_t *a,
+                       const dt_calendar_t *b, dt_join_t how) {
+    const dt_calendar_t *t;
+    join_t *joins;
+    size_t i;
+
+    if ((uintptr_t)b < (uintptr_t)a) {
+        t = a;
+        a = b;
+        b = t;
+    }
+    for (i = 0; i < cache->n; i++) {
+        if (cache->joins[i].a == a && cache->joins[i].b == b && cache->joins[i].how == how)
+            return cache->joins[i].cal;
+    }
+
+    if (cache->n == cache->size) {
+        joins = (join_t *)realloc(cache->joins, (cache->size * 2 + 4) * sizeof(join_t));
+        if (!joins)
+            return NULL;
+        cache->joins = joins;
+        cache->size  = cache->size * 2 + 4;
+    }
+    joins = &cache->joins[cache->n];
+    joins->cal = dt_calendar_join(a, b, how);
+    if (!joins->cal)
+        return NULL;
+    joins->a   = a;
+    joins->b   = b;
+    joins->how = how;
+    cache->n++;
+    return joins->cal;
+}
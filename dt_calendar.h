@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) 2012-2015 Christian Hansen <chansen@cpan.org>
+ * <https://github.com/chansen/c-dt>
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met: 
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer. 
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution. 
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef __DT_CALENDAR_H__
+#define __DT_CALENDAR_H__
+#include <stddef.h>
+#include "dt_core.h"
+#include "dt_weekday.h"
+#include "dt_workday.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct dt_calendar dt_calendar_t;
+typedef struct dt_calendar_cache dt_calendar_cache_t;
+
+typedef enum {
+    DT_JOIN_ALL,    /* a workday in both calendars, the union of their holidays */
+    DT_JOIN_ANY     /* a workday in either calendar */
+} dt_join_t;
+
+dt_calendar_t * dt_calendar_new             (dt_t first, dt_t last, unsigned int weekend,
+                                             const dt_t *holidays, size_t n);
+void            dt_calendar_free            (dt_calendar_t *cal);
+
+bool            dt_calendar_is_workday      (const dt_calendar_t *cal, dt_t dt);
+
+dt_t            dt_calendar_next_workday    (const dt_calendar_t *cal, dt_t dt, bool current);
+dt_t            dt_calendar_prev_workday    (const dt_calendar_t *cal, dt_t dt, bool current);
+
+dt_t            dt_calendar_roll_workday    (const dt_calendar_t *cal, dt_t dt, dt_bdc_t convention);
+
+dt_t            dt_calendar_add_workdays    (const dt_calendar_t *cal, dt_t dt, int delta);
+
+int             dt_calendar_delta_workdays  (const dt_calendar_t *cal, dt_t start, dt_t end, bool inclusive);
+
+dt_calendar_t * dt_calendar_join            (const dt_calendar_t *a, const dt_calendar_t *b, dt_join_t how);
+
+dt_calendar_cache_t *   dt_calendar_cache_new   (void);
+void                    dt_calendar_cache_free  (dt_calendar_cache_t *cache);
+const dt_calendar_t *   dt_calendar_cache_join  (dt_calendar_cache_t *cache, const dt_calendar_t *a,
+                                                 const dt_calendar_t *b, dt_join_t how);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
+
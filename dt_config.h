@@ -40,6 +40,12 @@
 #  define  __bool_true_false_are_defined 1
 #endif
 
+#if defined(_MSC_VER) && !defined(__cplusplus)
+#  define DT_INLINE static __inline
+#else
+#  define DT_INLINE static inline
+#endif
+
 /* Chronological Julian Date, January 1, 4713 BC, Monday
 #define DT_EPOCH_OFFSET 1721425
 */
@@ -27,6 +27,13 @@
 #include <inttypes.h>
 #include "dt_core.h"
 #include "dt_util.h"
+#include "dt64.h"
+#include "dt_kernel.h"
+
+#ifdef DT_YMD_TABLE
+#  define DT_YMD_TABLE_DEFINE
+#  include "dt_ymd_table.h"
+#endif
 
 #define LEAP_YEAR(y) \
     (((y) & 3) == 0 && ((y) % 100 != 0 || (y) % 400 == 0))
@@ -104,36 +111,11 @@ dt_from_ywd(int y, int w, int d) {
  * set of functions.
  */
 
-typedef int64_t dt64_t;
-
-static inline bool
-dt64_from_yd(int y, int d, dt64_t *v, bool check) {
-    if (d < 1 || d > dt_days_in_year(y))
-        return false;
-    int64_t y64 = y - 1;
-    int64_t d64 = d;
-    if (y64 < 0) {
-        const int64_t n400 = 1 - y64/400;
-        y64 += n400 * 400;
-        d64 -= n400 * 146097;
-    }
-    *v = 365 * y64 + y64/4 - y64/100 + y64/400 + d64 + DT_EPOCH_OFFSET;
-    if (check && (*v < INT32_MIN || *v > INT32_MAX))
-        return false;
-    return true;
-}
-
 bool
 dt_from_yd_checked(int y, int d, dt_t *val) {
-    dt64_t v = 0;
-    if (!dt64_from_yd(y, d, &v, true))
-           return false;
-#ifndef NDEBUG
-    int32_t highw = v >> 32;
-    assert(highw == 0 || highw == -1);
-#endif
-    *val = (dt_t)v;
-    return true;
+    if (d < 1 || d > dt_days_in_year(y))
+        return false;
+    return dt64_to_dt(dt64_from_yd(y, d), val);
 }
 
 bool
@@ -160,24 +142,55 @@ dt_from_ywd_checked(int y, int w, int d, dt_t *val) {
         return false;
     if (w < 1 || w > dt_weeks_in_year(y))
         return false;
+    return dt64_to_dt(dt64_from_ywd(y, w, d), val);
+}
+#endif
 
-    /* The first week of the year always contains 4 January. */
-    dt64_t dt = 0;
-    bool rc = dt64_from_yd(y, 4, &dt, false);
-    assert(rc);
-    (void)rc;
 
-    dt -= dt_dow(dt);
-    dt += w * 7 + d - 7;
-    if (dt < INT32_MIN || dt > INT32_MAX)
-        return false;
+#ifdef DT_EAF
+/*
+ * Conversion based on the Euclidean affine functions described by Cassio Neri
+ * and Lorenz Schneider in "Euclidean Affine Functions and Applications to
+ * Calendar Algorithms". The kernel lives in dt_kernel.h and is shared with
+ * the dt64_t functions.
+ */
+void
+dt_to_yd(dt_t dt, int *yp, int *dp) {
+    int64_t y;
+    int n, l;
+
+#ifdef DT_YMD_TABLE
+    if (DT_YMD_TABLE_INDEX(dt) < DT_YMD_TABLE_SIZE) {
+        const uint32_t e = dt_ymd_table[DT_YMD_TABLE_INDEX(dt)];
+        if (yp) *yp = DT_YMD_ENTRY_YEAR(e);
+        if (dp) *dp = DT_YMD_ENTRY_DOY(e);
+        return;
+    }
+#endif
 
-    *val = (dt_t)dt;
-    return true;
+    dt_kernel_decompose((int64_t)dt - DT_EPOCH_OFFSET, &y, &n, &l);
+    dt_kernel_to_yd(y, n, l, yp, dp);
 }
-#endif
 
+void
+dt_to_ymd(dt_t dt, int *yp, int *mp, int *dp) {
+    int64_t y;
+    int n, l;
+
+#ifdef DT_YMD_TABLE
+    if (DT_YMD_TABLE_INDEX(dt) < DT_YMD_TABLE_SIZE) {
+        const uint32_t e = dt_ymd_table[DT_YMD_TABLE_INDEX(dt)];
+        if (yp) *yp = DT_YMD_ENTRY_YEAR(e);
+        if (mp) *mp = DT_YMD_ENTRY_MONTH(e);
+        if (dp) *dp = DT_YMD_ENTRY_DAY(e);
+        return;
+    }
+#endif
 
+    dt_kernel_decompose((int64_t)dt - DT_EPOCH_OFFSET, &y, &n, &l);
+    dt_kernel_to_ymd(y, n, yp, mp, dp);
+}
+#else
 #ifndef DT_NO_SHORTCUTS
 static const dt_t DT1901 = 693961 + DT_EPOCH_OFFSET; /* 1901-01-01 */
 static const dt_t DT2099 = 766644 + DT_EPOCH_OFFSET; /* 2099-12-31 */
@@ -187,6 +200,15 @@ void
 dt_to_yd(dt_t d, int *yp, int *dp) {
     int y, n100, n1;
 
+#ifdef DT_YMD_TABLE
+    if (DT_YMD_TABLE_INDEX(d) < DT_YMD_TABLE_SIZE) {
+        const uint32_t e = dt_ymd_table[DT_YMD_TABLE_INDEX(d)];
+        if (yp) *yp = DT_YMD_ENTRY_YEAR(e);
+        if (dp) *dp = DT_YMD_ENTRY_DOY(e);
+        return;
+    }
+#endif
+
     y = 0;
 #ifndef DT_NO_SHORTCUTS
     /* Shortcut dates between the years 1901-2099 inclusive */
@@ -233,6 +255,16 @@ void
 dt_to_ymd(dt_t dt, int *yp, int *mp, int *dp) {
     int y, doy, m, l;
 
+#ifdef DT_YMD_TABLE
+    if (DT_YMD_TABLE_INDEX(dt) < DT_YMD_TABLE_SIZE) {
+        const uint32_t e = dt_ymd_table[DT_YMD_TABLE_INDEX(dt)];
+        if (yp) *yp = DT_YMD_ENTRY_YEAR(e);
+        if (mp) *mp = DT_YMD_ENTRY_MONTH(e);
+        if (dp) *dp = DT_YMD_ENTRY_DAY(e);
+        return;
+    }
+#endif
+
     dt_to_yd(dt, &y, &doy);
     l = LEAP_YEAR(y);
     m = doy < 32 ? 1 : 1 + (5 * (doy - 59 - l) + 303) / 153;
@@ -245,13 +277,27 @@ dt_to_ymd(dt_t dt, int *yp, int *mp, int *dp) {
     if (dp) *dp = doy - days_preceding_month[l][m];
 }
 
+#endif
+
 void
 dt_to_yqd(dt_t dt, int *yp, int *qp, int *dp) {
     int y, doy, q, l;
 
-    dt_to_yd(dt, &y, &doy);
-    l = LEAP_YEAR(y);
-    q = doy < 91 ? 1 : 1 + (5 * (doy - 59 - l) + 303) / 459;
+#ifdef DT_YMD_TABLE
+    if (DT_YMD_TABLE_INDEX(dt) < DT_YMD_TABLE_SIZE) {
+        const uint32_t e = dt_ymd_table[DT_YMD_TABLE_INDEX(dt)];
+        y   = DT_YMD_ENTRY_YEAR(e);
+        doy = DT_YMD_ENTRY_DOY(e);
+        l   = DT_YMD_ENTRY_LEAP(e);
+        q   = (DT_YMD_ENTRY_MONTH(e) + 2) / 3;
+    }
+    else
+#endif
+    {
+        dt_to_yd(dt, &y, &doy);
+        l = LEAP_YEAR(y);
+        q = doy < 91 ? 1 : 1 + (5 * (doy - 59 - l) + 303) / 459;
+    }
 
     assert(q >= 1);
     assert(q <= 4);
@@ -265,8 +311,19 @@ void
 dt_to_ywd(dt_t dt, int *yp, int *wp, int *dp) {
     int y, doy, dow;
 
-    dt_to_yd(dt, &y, &doy);
-    dow = dt_dow(dt);
+#ifdef DT_YMD_TABLE
+    if (DT_YMD_TABLE_INDEX(dt) < DT_YMD_TABLE_SIZE) {
+        const uint32_t e = dt_ymd_table[DT_YMD_TABLE_INDEX(dt)];
+        y   = DT_YMD_ENTRY_YEAR(e);
+        doy = DT_YMD_ENTRY_DOY(e);
+        dow = DT_YMD_ENTRY_DOW(e);
+    }
+    else
+#endif
+    {
+        dt_to_yd(dt, &y, &doy);
+        dow = dt_dow(dt);
+    }
     doy = doy + 4 - dow;
     if (doy < 1) {
         y--;
@@ -291,7 +348,13 @@ dt_rdn(dt_t dt) {
 
 dt_dow_t
 dt_dow(dt_t dt) {
-    int dow = (dt - DT_EPOCH_OFFSET) % 7;
+    int dow;
+
+#ifdef DT_YMD_TABLE
+    if (DT_YMD_TABLE_INDEX(dt) < DT_YMD_TABLE_SIZE)
+        return DT_YMD_ENTRY_DOW(dt_ymd_table[DT_YMD_TABLE_INDEX(dt)]);
+#endif
+    dow = (dt - DT_EPOCH_OFFSET) % 7;
     if (dow < 1)
         dow += 7;
     assert(dow >= 1);
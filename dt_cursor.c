@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) 2012-2015 Christian Hansen <chansen@cpan.org>
+ * <https://github.com/chansen/c-dt>
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met: 
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer. 
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution. 
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "dt_core.h"
+#include "dt_util.h"
+#include "dt_cursor.h"
+
+/*
+ * A move of at most MAX_STEP days carries the fields from month to month
+ * and from week to week; a longer one decodes the date from scratch.
+ */
+#define MAX_STEP 31
+
+static const int days_in_month[2][13] = {
+    { 0, 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 },
+    { 0, 31, 29, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 }
+};
+
+static const int days_preceding_month[2][13] = {
+    { 0, 0, 31, 59, 90, 120, 151, 181, 212, 243, 273, 304, 334 },
+    { 0, 0, 31, 60, 91, 121, 152, 182, 213, 244, 274, 305, 335 }
+};
+
+static const int quarter_of_month[13] = {
+    0, 1, 1, 1, 2, 2, 2, 3, 3, 3, 4, 4, 4
+};
+
+void
+dt_cursor_init(dt_cursor_t *c, dt_t dt) {
+    c->dt = dt;
+    dt_to_ymd(dt, &c->year, &c->month, &c->day);
+    dt_to_ywd(dt, &c->week_year, &c->week, &c->dow);
+    c->leap    = dt_leap_year(c->year);
+    c->doy     = days_preceding_month[c->leap][c->month] + c->day;
+    c->quarter = quarter_of_month[c->month];
+}
+
+void
+dt_cursor_add_days(dt_cursor_t *c, int delta) {
+    int d, n;
+
+    if (delta > MAX_STEP || delta < -MAX_STEP) {
+        dt_cursor_init(c, c->dt + delta);
+        return;
+    }
+    c->dt += delta;
+
+    d = c->day + delta;
+    if (delta > 0) {
+        while (d > (n = days_in_month[c->leap][c->month])) {
+            d -= n;
+            if (++c->month > 12) {
+                c->month = 1;
+                c->leap  = dt_leap_year(++c->year);
+            }
+        }
+    }
+    else {
+        while (d < 1) {
+            if (--c->month < 1) {
+                c->month = 12;
+                c->leap  = dt_leap_year(--c->year);
+            }
+            d += days_in_month[c->leap][c->month];
+        }
+    }
+    c->day     = d;
+    c->doy     = days_preceding_month[c->leap][c->month] + d;
+    c->quarter = quarter_of_month[c->month];
+
+    d = c->dow + delta;
+    for (; d > 7; d -= 7) {
+        if (++c->week > 52 && c->week > dt_weeks_in_year(c->week_year)) {
+            c->week = 1;
+            c->week_year++;
+        }
+    }
+    for (; d < 1; d += 7) {
+        if (--c->week < 1)
+            c->week = dt_weeks_in_year(--c->week_year);
+    }
+    c->dow = d;
+}
+
+/* Moves to dt, by carrying the fields if it is near */
+void
+dt_cursor_set(dt_cursor_t *c, dt_t dt) {
+    dt_cursor_add_days(c, dt - c->dt);
+}
+
+void
+dt_cursor_next(dt_cursor_t *c) {
+    dt_cursor_add_days(c, 1);
+}
+
+void
+dt_cursor_prev(dt_cursor_t *c) {
+    dt_cursor_add_days(c, -1);
+}
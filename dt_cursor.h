@@ -0,0 +1,60 @@
+/*
+ * Copyright (c) 2012-2015 Christian Hansen <chansen@cpan.org>
+ * <https://github.com/chansen/c-dt>
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met: 
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer. 
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution. 
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef __DT_CURSOR_H__
+#define __DT_CURSOR_H__
+#include "dt_core.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * A date together with its decoded fields, kept up to date as the date
+ * moves by a few days at a time.
+ */
+typedef struct {
+    dt_t dt;
+    int  year;
+    int  month;
+    int  day;           /* day of month */
+    int  doy;           /* day of year */
+    int  dow;           /* DT_MONDAY through DT_SUNDAY */
+    int  quarter;
+    int  week_year;     /* ISO 8601 week-numbering year */
+    int  week;          /* ISO 8601 week */
+    bool leap;          /* year is a leap year */
+} dt_cursor_t;
+
+void    dt_cursor_init      (dt_cursor_t *c, dt_t dt);
+void    dt_cursor_set       (dt_cursor_t *c, dt_t dt);
+void    dt_cursor_add_days  (dt_cursor_t *c, int delta);
+void    dt_cursor_next      (dt_cursor_t *c);
+void    dt_cursor_prev      (dt_cursor_t *c);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
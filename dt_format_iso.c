@@ -0,0 +1,292 @@
+/*
+ * Copyright (c) 2012-2015 Christian Hansen <chansen@cpan.org>
+ * <https://github.com/chansen/c-dt>
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met: 
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer. 
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution. 
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <stddef.h>
+#include <string.h>
+#include "dt_core.h"
+#include "dt_format_iso.h"
+#define DT_WRITER_DEFINE
+#include "dt_writer.h"
+
+/*
+ * Every formatter writes into a local buffer when the destination may be
+ * too small for the longest result, so the common case stores directly
+ * into the caller's buffer. The result is always NUL-terminated, the
+ * return value is its length or 0 if it does not fit.
+ */
+
+/* Longest results: a sign and 10 digits year, "-Www-D" or "T" "hh:mm:ss.fffffffff" "+hh:mm" */
+#define DATE_MAX        (11 + 6)
+#define TIME_MAX        (8 + 10)
+#define ZONE_MAX        6
+#define DATETIME_MAX    (DATE_MAX + 1 + TIME_MAX + ZONE_MAX)
+
+static char *
+put_time(char *p, int sod, int nsec, int precision, bool extended) {
+    int h, m, s;
+
+    h = sod / 3600;
+    m = sod / 60 % 60;
+    s = sod % 60;
+    if (sod == 86400)
+        h = 24, m = s = 0;
+
+    p = dt_writer_put2(p, h);
+    if (extended)
+        *p++ = ':';
+    p = dt_writer_put2(p, m);
+    if (extended)
+        *p++ = ':';
+    p = dt_writer_put2(p, s);
+
+    if (precision > 0) {
+        if (precision > 9)
+            precision = 9;
+        *p++ = '.';
+        p = dt_writer_put_fraction(p, nsec, precision);
+    }
+    return p;
+}
+
+static char *
+put_zone(char *p, int offset, bool extended) {
+    if (offset == 0) {
+        *p++ = 'Z';
+        return p;
+    }
+    return dt_writer_put_offset(p, offset, extended);
+}
+
+static size_t
+finish(char *dst, size_t len, char *buf, char *end) {
+    size_t n = end - buf;
+
+    if (buf != dst) {
+        if (n >= len)
+            return 0;
+        memcpy(dst, buf, n);
+    }
+    dst[n] = 0;
+    return n;
+}
+
+#define BEGIN(max)                                  \
+    char tmp[max + 1];                              \
+    char * const buf = len > (max) ? dst : tmp;     \
+    char *p = buf
+
+#define END() \
+    return finish(dst, len, buf, p)
+
+static size_t
+format_ymd(char *dst, size_t len, dt_t dt, bool extended) {
+    int y, m, d;
+    BEGIN(DATE_MAX);
+
+    dt_to_ymd(dt, &y, &m, &d);
+    p = dt_writer_put_year(p, y, true);
+    if (extended)
+        *p++ = '-';
+    p = dt_writer_put2(p, m);
+    if (extended)
+        *p++ = '-';
+    p = dt_writer_put2(p, d);
+    END();
+}
+
+static size_t
+format_yd(char *dst, size_t len, dt_t dt, bool extended) {
+    int y, d;
+    BEGIN(DATE_MAX);
+
+    dt_to_yd(dt, &y, &d);
+    p = dt_writer_put_year(p, y, true);
+    if (extended)
+        *p++ = '-';
+    *p++ = (char)('0' + d / 100);
+    p = dt_writer_put2(p, d % 100);
+    END();
+}
+
+static size_t
+format_ywd(char *dst, size_t len, dt_t dt, bool extended) {
+    int y, w, d;
+    BEGIN(DATE_MAX);
+
+    dt_to_ywd(dt, &y, &w, &d);
+    p = dt_writer_put_year(p, y, true);
+    if (extended)
+        *p++ = '-';
+    *p++ = 'W';
+    p = dt_writer_put2(p, w);
+    if (extended)
+        *p++ = '-';
+    *p++ = (char)('0' + d);
+    END();
+}
+
+static size_t
+format_yqd(char *dst, size_t len, dt_t dt, bool extended) {
+    int y, q, d;
+    BEGIN(DATE_MAX);
+
+    dt_to_yqd(dt, &y, &q, &d);
+    p = dt_writer_put_year(p, y, true);
+    if (extended)
+        *p++ = '-';
+    *p++ = 'Q';
+    *p++ = (char)('0' + q);
+    if (extended)
+        *p++ = '-';
+    p = dt_writer_put2(p, d);
+    END();
+}
+
+/*
+ *  Basic      Extended
+ *  20121224   2012-12-24   Calendar date   (ISO 8601)
+ *  2012359    2012-359     Ordinal date    (ISO 8601)
+ *  2012W521   2012-W52-1   Week date       (ISO 8601)
+ *  2012Q485   2012-Q4-85   Quarter date
+ */
+
+size_t
+dt_format_iso_date(char *dst, size_t len, dt_t dt) {
+    return format_ymd(dst, len, dt, true);
+}
+
+size_t
+dt_format_iso_date_basic(char *dst, size_t len, dt_t dt) {
+    return format_ymd(dst, len, dt, false);
+}
+
+size_t
+dt_format_iso_ordinal_date(char *dst, size_t len, dt_t dt) {
+    return format_yd(dst, len, dt, true);
+}
+
+size_t
+dt_format_iso_ordinal_date_basic(char *dst, size_t len, dt_t dt) {
+    return format_yd(dst, len, dt, false);
+}
+
+size_t
+dt_format_iso_week_date(char *dst, size_t len, dt_t dt) {
+    return format_ywd(dst, len, dt, true);
+}
+
+size_t
+dt_format_iso_week_date_basic(char *dst, size_t len, dt_t dt) {
+    return format_ywd(dst, len, dt, false);
+}
+
+size_t
+dt_format_iso_quarter_date(char *dst, size_t len, dt_t dt) {
+    return format_yqd(dst, len, dt, true);
+}
+
+size_t
+dt_format_iso_quarter_date_basic(char *dst, size_t len, dt_t dt) {
+    return format_yqd(dst, len, dt, false);
+}
+
+/*
+ *  Basic               Extended
+ *  123045              12:30:45
+ *  123045.123456789    12:30:45.123456789
+ *
+ *  The precision is the number of fractional digits (0-9).
+ */
+
+size_t
+dt_format_iso_time(char *dst, size_t len, int sod, int nsec, int precision) {
+    BEGIN(TIME_MAX);
+
+    if (!dt_writer_valid_time(sod, nsec))
+        return 0;
+    p = put_time(p, sod, nsec, precision, true);
+    END();
+}
+
+size_t
+dt_format_iso_time_basic(char *dst, size_t len, int sod, int nsec, int precision) {
+    BEGIN(TIME_MAX);
+
+    if (!dt_writer_valid_time(sod, nsec))
+        return 0;
+    p = put_time(p, sod, nsec, precision, false);
+    END();
+}
+
+/*
+ *  Basic    Extended
+ *  Z        Z
+ *  ±hhmm    ±hh:mm
+ */
+
+size_t
+dt_format_iso_zone(char *dst, size_t len, int offset) {
+    BEGIN(ZONE_MAX);
+
+    if (!dt_writer_valid_offset(offset))
+        return 0;
+    p = put_zone(p, offset, true);
+    END();
+}
+
+size_t
+dt_format_iso_zone_basic(char *dst, size_t len, int offset) {
+    BEGIN(ZONE_MAX);
+
+    if (!dt_writer_valid_offset(offset))
+        return 0;
+    p = put_zone(p, offset, false);
+    END();
+}
+
+/*
+ *  2012-12-24T12:30:45Z
+ *  2012-12-24T12:30:45.123+01:00
+ */
+
+size_t
+dt_format_iso_datetime(char *dst, size_t len, dt_t dt, int sod, int nsec,
+                       int precision, int offset) {
+    int y, m, d;
+    BEGIN(DATETIME_MAX);
+
+    if (!dt_writer_valid_time(sod, nsec) || !dt_writer_valid_offset(offset))
+        return 0;
+    dt_to_ymd(dt, &y, &m, &d);
+    p = dt_writer_put_year(p, y, true);
+    *p++ = '-';
+    p = dt_writer_put2(p, m);
+    *p++ = '-';
+    p = dt_writer_put2(p, d);
+    *p++ = 'T';
+    p = put_time(p, sod, nsec, precision, true);
+    p = put_zone(p, offset, true);
+    END();
+}
@@ -0,0 +1,318 @@
+/*
+ * Copyright (c) 2012-2015 Christian Hansen <chansen@cpan.org>
+ * <https://github.com/chansen/c-dt>
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met: 
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer. 
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution. 
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <stddef.h>
+#include <string.h>
+#include "dt_core.h"
+#include "dt_format_pattern.h"
+#include "dt_writer.h"
+
+/*
+ * A pattern is compiled into a string of opcodes ending with OP_END. Each
+ * conversion specification becomes one opcode, followed by the number of
+ * digits for OP_FRACTION, and a run of literal characters is OP_LITERAL,
+ * its length and the characters. Compiling also records which parts of
+ * the date the pattern needs, so that formatting decodes each of them
+ * once, and the longest result, so that a large enough destination is
+ * written directly. The result is always NUL-terminated, the return
+ * value is its length or 0 if it does not fit.
+ */
+enum {
+    OP_END = 0,
+    OP_LITERAL,
+    OP_YEAR,            /* %Y */
+    OP_YEAR2,           /* %y */
+    OP_MONTH,           /* %m */
+    OP_DAY,             /* %d */
+    OP_DAY_SPACE,       /* %e */
+    OP_DOY,             /* %j */
+    OP_WEEK_YEAR,       /* %G */
+    OP_WEEK,            /* %V */
+    OP_WEEKDAY,         /* %u */
+    OP_WEEKDAY0,        /* %w */
+    OP_MONTH_ABBR,      /* %b %h */
+    OP_MONTH_NAME,      /* %B */
+    OP_WEEKDAY_ABBR,    /* %a */
+    OP_WEEKDAY_NAME,    /* %A */
+    OP_HOUR,            /* %H */
+    OP_HOUR12,          /* %I */
+    OP_MINUTE,          /* %M */
+    OP_SECOND,          /* %S */
+    OP_AMPM,            /* %p */
+    OP_FRACTION,        /* %f %1f .. %9f */
+    OP_OFFSET,          /* %z */
+    OP_OFFSET_EXT       /* %:z */
+};
+
+#define NEED_YMD    0x01
+#define NEED_YD     0x02
+#define NEED_YWD    0x04
+#define NEED_DOW    0x08
+#define NEED_TIME   0x10
+#define NEED_OFFSET 0x20
+
+/* A sign and 10 digits year, the longest of any single conversion */
+#define OP_MAX      11
+#define FORMAT_MAX  (DT_FORMAT_PATTERN_SIZE * OP_MAX)
+
+#define NO_LITERAL  DT_FORMAT_PATTERN_SIZE
+
+static const char month_names[12][10] = {
+    "January", "February", "March", "April", "May", "June",
+    "July", "August", "September", "October", "November", "December"
+};
+
+static const unsigned char month_lengths[12] = {
+    7, 8, 5, 5, 3, 4, 4, 6, 9, 7, 8, 8
+};
+
+static const char weekday_names[7][10] = {
+    "Monday", "Tuesday", "Wednesday", "Thursday", "Friday", "Saturday", "Sunday"
+};
+
+static const unsigned char weekday_lengths[7] = {
+    6, 7, 9, 8, 6, 8, 6
+};
+
+static bool
+emit(dt_format_pattern_t *pat, size_t *np, size_t *litp, unsigned char op, int width, unsigned int fields) {
+    if (*np >= DT_FORMAT_PATTERN_SIZE - 1)
+        return false;
+    pat->code[(*np)++] = op;
+    pat->max += width;
+    pat->fields |= fields;
+    *litp = NO_LITERAL;
+    return true;
+}
+
+static bool
+emit_literal(dt_format_pattern_t *pat, size_t *np, size_t *litp, char c) {
+    if (*litp == NO_LITERAL || pat->code[*litp] == 255) {
+        if (!emit(pat, np, litp, OP_LITERAL, 0, 0) || *np >= DT_FORMAT_PATTERN_SIZE - 1)
+            return false;
+        *litp = *np;
+        pat->code[(*np)++] = 0;
+    }
+    if (*np >= DT_FORMAT_PATTERN_SIZE - 1)
+        return false;
+    pat->code[*litp]++;
+    pat->code[(*np)++] = (unsigned char)c;
+    pat->max++;
+    return true;
+}
+
+static bool
+compile(dt_format_pattern_t *pat, size_t *np, size_t *litp, const char *s) {
+    bool ok;
+    int k;
+
+    for (; *s; s++) {
+        if (*s != '%' || s[1] == '%') {
+            s += *s == '%';
+            if (!emit_literal(pat, np, litp, *s))
+                return false;
+            continue;
+        }
+        switch (*++s) {
+            case 'Y': ok = emit(pat, np, litp, OP_YEAR, OP_MAX, NEED_YMD);          break;
+            case 'y': ok = emit(pat, np, litp, OP_YEAR2, 2, NEED_YMD);              break;
+            case 'm': ok = emit(pat, np, litp, OP_MONTH, 2, NEED_YMD);              break;
+            case 'd': ok = emit(pat, np, litp, OP_DAY, 2, NEED_YMD);                break;
+            case 'e': ok = emit(pat, np, litp, OP_DAY_SPACE, 2, NEED_YMD);          break;
+            case 'j': ok = emit(pat, np, litp, OP_DOY, 3, NEED_YD);                 break;
+            case 'G': ok = emit(pat, np, litp, OP_WEEK_YEAR, OP_MAX, NEED_YWD);     break;
+            case 'V': ok = emit(pat, np, litp, OP_WEEK, 2, NEED_YWD);               break;
+            case 'u': ok = emit(pat, np, litp, OP_WEEKDAY, 1, NEED_DOW);            break;
+            case 'w': ok = emit(pat, np, litp, OP_WEEKDAY0, 1, NEED_DOW);           break;
+            case 'b':
+            case 'h': ok = emit(pat, np, litp, OP_MONTH_ABBR, 3, NEED_YMD);         break;
+            case 'B': ok = emit(pat, np, litp, OP_MONTH_NAME, 9, NEED_YMD);         break;
+            case 'a': ok = emit(pat, np, litp, OP_WEEKDAY_ABBR, 3, NEED_DOW);       break;
+            case 'A': ok = emit(pat, np, litp, OP_WEEKDAY_NAME, 9, NEED_DOW);       break;
+            case 'H': ok = emit(pat, np, litp, OP_HOUR, 2, NEED_TIME);              break;
+            case 'I': ok = emit(pat, np, litp, OP_HOUR12, 2, NEED_TIME);            break;
+            case 'M': ok = emit(pat, np, litp, OP_MINUTE, 2, NEED_TIME);            break;
+            case 'S': ok = emit(pat, np, litp, OP_SECOND, 2, NEED_TIME);            break;
+            case 'p': ok = emit(pat, np, litp, OP_AMPM, 2, NEED_TIME);              break;
+            case 'z': ok = emit(pat, np, litp, OP_OFFSET, 5, NEED_OFFSET);          break;
+            case ':':
+                ok = *++s == 'z' && emit(pat, np, litp, OP_OFFSET_EXT, 6, NEED_OFFSET);
+                break;
+            case 'f':
+            case '1': case '2': case '3': case '4': case '5':
+            case '6': case '7': case '8': case '9':
+                k = *s == 'f' ? 9 : *s - '0';
+                ok = (*s == 'f' || *++s == 'f')
+                  && emit(pat, np, litp, OP_FRACTION, 0, NEED_TIME)
+                  && emit(pat, np, litp, (unsigned char)k, k, 0);
+                break;
+            case 'n': ok = emit_literal(pat, np, litp, '\n');                       break;
+            case 't': ok = emit_literal(pat, np, litp, '\t');                       break;
+            case 'D': ok = compile(pat, np, litp, "%m/%d/%y");                      break;
+            case 'F': ok = compile(pat, np, litp, "%Y-%m-%d");                      break;
+            case 'R': ok = compile(pat, np, litp, "%H:%M");                         break;
+            case 'T': ok = compile(pat, np, litp, "%H:%M:%S");                      break;
+            default:  ok = false;                                                   break;
+        }
+        if (!ok)
+            return false;
+    }
+    return true;
+}
+
+bool
+dt_format_pattern_compile(dt_format_pattern_t *pat, const char *pattern) {
+    size_t n, lit;
+
+    n = 0;
+    lit = NO_LITERAL;
+    pat->fields = 0;
+    pat->max = 0;
+    if (!compile(pat, &n, &lit, pattern))
+        return false;
+    pat->code[n] = OP_END;
+    return true;
+}
+
+size_t
+dt_format_pattern(const dt_format_pattern_t *pat, char *dst, size_t len,
+                  dt_t dt, int sod, int nsec, int offset) {
+    const unsigned char *code;
+    char tmp[FORMAT_MAX + 1];
+    char *buf, *p;
+    int y, m, d, doy, wy, w, dow, h;
+    size_t n;
+
+    if ((pat->fields & NEED_TIME) && !dt_writer_valid_time(sod, nsec))
+        return 0;
+    if ((pat->fields & NEED_OFFSET) && !dt_writer_valid_offset(offset))
+        return 0;
+
+    y = m = d = doy = wy = w = dow = 0;
+    if (pat->fields & NEED_YMD)
+        dt_to_ymd(dt, &y, &m, &d);
+    if (pat->fields & NEED_YD)
+        dt_to_yd(dt, &y, &doy);
+    if (pat->fields & NEED_YWD)
+        dt_to_ywd(dt, &wy, &w, &dow);
+    else if (pat->fields & NEED_DOW)
+        dow = dt_dow(dt);
+
+    buf = len > pat->max ? dst : tmp;
+    for (p = buf, code = pat->code; *code != OP_END; code++) {
+        switch (*code) {
+            case OP_LITERAL:
+                n = *++code;
+                memcpy(p, code + 1, n);
+                p += n;
+                code += n;
+                break;
+            case OP_YEAR:
+                p = dt_writer_put_year(p, y, false);
+                break;
+            case OP_YEAR2:
+                p = dt_writer_put2(p, (unsigned int)(y % 100 + 100) % 100);
+                break;
+            case OP_MONTH:
+                p = dt_writer_put2(p, m);
+                break;
+            case OP_DAY:
+                p = dt_writer_put2(p, d);
+                break;
+            case OP_DAY_SPACE:
+                p = dt_writer_put2(p, d);
+                if (d < 10)
+                    p[-2] = ' ';
+                break;
+            case OP_DOY:
+                *p++ = (char)('0' + doy / 100);
+                p = dt_writer_put2(p, doy % 100);
+                break;
+            case OP_WEEK_YEAR:
+                p = dt_writer_put_year(p, wy, false);
+                break;
+            case OP_WEEK:
+                p = dt_writer_put2(p, w);
+                break;
+            case OP_WEEKDAY:
+                *p++ = (char)('0' + dow);
+                break;
+            case OP_WEEKDAY0:
+                *p++ = (char)('0' + dow % 7);
+                break;
+            case OP_MONTH_ABBR:
+                memcpy(p, month_names[m - 1], 3);
+                p += 3;
+                break;
+            case OP_MONTH_NAME:
+                memcpy(p, month_names[m - 1], month_lengths[m - 1]);
+                p += month_lengths[m - 1];
+                break;
+            case OP_WEEKDAY_ABBR:
+                memcpy(p, weekday_names[dow - 1], 3);
+                p += 3;
+                break;
+            case OP_WEEKDAY_NAME:
+                memcpy(p, weekday_names[dow - 1], weekday_lengths[dow - 1]);
+                p += weekday_lengths[dow - 1];
+                break;
+            case OP_HOUR:
+                p = dt_writer_put2(p, sod / 3600);
+                break;
+            case OP_HOUR12:
+                h = sod / 3600 % 12;
+                p = dt_writer_put2(p, h ? h : 12);
+                break;
+            case OP_MINUTE:
+                p = dt_writer_put2(p, sod / 60 % 60);
+                break;
+            case OP_SECOND:
+                p = dt_writer_put2(p, sod % 60);
+                break;
+            case OP_AMPM:
+                *p++ = sod / 3600 % 24 < 12 ? 'A' : 'P';
+                *p++ = 'M';
+                break;
+            case OP_FRACTION:
+                p = dt_writer_put_fraction(p, nsec, *++code);
+                break;
+            case OP_OFFSET:
+                p = dt_writer_put_offset(p, offset, false);
+                break;
+            case OP_OFFSET_EXT:
+                p = dt_writer_put_offset(p, offset, true);
+                break;
+        }
+    }
+
+    n = p - buf;
+    if (buf != dst) {
+        if (n >= len)
+            return 0;
+        memcpy(dst, buf, n);
+    }
+    dst[n] = 0;
+    return n;
+}
@@ -0,0 +1,375 @@
+/*
+ * Copyright (c) 2012-2015 Christian Hansen <chansen@cpan.org>
+ * <https://github.com/chansen/c-dt>
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met: 
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer. 
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution. 
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include "dt_core.h"
+#include "dt_dow.h"
+#include "dt_easter.h"
+#include "dt_valid.h"
+#include "dt_weekday.h"
+#include "dt_calendar.h"
+#include "dt_holiday.h"
+
+/*
+ * The rules are expanded one year at a time, on first use. The cache is
+ * a window of consecutive years that grows towards each year asked for;
+ * every year keeps its own array, so pointers handed out stay valid until
+ * dt_holidays_free(). A year holds the holidays observed within it, which
+ * may come from the rules of an adjacent year: New Year's Day on a
+ * Saturday, observed on the nearest weekday, falls on the previous
+ * December 31st.
+ */
+typedef struct {
+    dt_t   *days;
+    size_t  n;
+    bool    done;
+} year_t;
+
+struct dt_holidays {
+    dt_holiday_rule_t *rules;
+    size_t             nrules;
+    dt_weekend_t       wk;
+    int                y0;
+    size_t             nyears;
+    year_t            *years;
+    dt_t              *scratch;     /* 3 * nrules entries */
+};
+
+static int
+compare_dt(const void *a, const void *b) {
+    const dt_t x = *(const dt_t *)a;
+    const dt_t y = *(const dt_t *)b;
+    return (x > y) - (x < y);
+}
+
+static bool
+contains(const dt_t *days, size_t n, dt_t dt) {
+    size_t i;
+
+    for (i = 0; i < n; i++) {
+        if (days[i] == dt)
+            return true;
+    }
+    return false;
+}
+
+static bool
+valid_rule(const dt_holiday_rule_t *r) {
+    switch (r->rule) {
+        case DT_RULE_FIXED:
+            if (r->month < 1 || r->month > 12 || r->day < 1 || r->day > 31)
+                return false;
+            break;
+        case DT_RULE_NTH_DOW:
+            if (r->month < 1 || r->month > 12 || r->day < -5 || r->day > 5 || !r->day)
+                return false;
+            if (r->dow < DT_MONDAY || r->dow > DT_SUNDAY)
+                return false;
+            break;
+        case DT_RULE_EASTER:
+            if (r->computus != DT_WESTERN && r->computus != DT_ORTHODOX)
+                return false;
+            break;
+        default:
+            return false;
+    }
+    if (r->observe < DT_OBSERVE_ACTUAL || r->observe > DT_OBSERVE_SUBSTITUTE)
+        return false;
+    return true;
+}
+
+/* Stores the date of rule r in year y in dtp, returns false if it has none that year */
+static bool
+rule_date(const dt_holiday_rule_t *r, int y, dt_t *dtp) {
+    dt_t first, last;
+
+    if ((r->first_year && y < r->first_year) || (r->last_year && y > r->last_year))
+        return false;
+    switch (r->rule) {
+        case DT_RULE_FIXED:
+            if (!dt_valid_ymd(y, r->month, r->day))
+                return false;
+            *dtp = dt_from_ymd(y, r->month, r->day);
+            return true;
+        case DT_RULE_NTH_DOW:
+            first = dt_from_ymd(y, r->month, 1);
+            last  = dt_from_ymd(y, r->month + 1, 0);
+            *dtp  = dt_nth_dow(r->day > 0 ? first : last, r->day, r->dow);
+            return *dtp >= first && *dtp <= last;
+        case DT_RULE_EASTER:
+            if (y < 1)
+                return false;
+            *dtp = dt_from_easter(y, r->computus) + r->day;
+            return true;
+    }
+    return false;
+}
+
+static dt_t
+observe(const dt_holidays_t *h, dt_observe_t how, dt_t dt) {
+    dt_t prev, next;
+
+    if (dt_weekend_is_weekday(&h->wk, dt))
+        return dt;
+    switch (how) {
+        case DT_OBSERVE_NEAREST:
+            prev = dt_weekend_prev_weekday(&h->wk, dt, false);
+            next = dt_weekend_next_weekday(&h->wk, dt, false);
+            return (dt - prev < next - dt) ? prev : next;
+        case DT_OBSERVE_FOLLOWING:
+            return dt_weekend_next_weekday(&h->wk, dt, false);
+        case DT_OBSERVE_PRECEDING:
+            return dt_weekend_prev_weekday(&h->wk, dt, false);
+        default:
+            return dt;
+    }
+}
+
+/*
+ * Stores the observed dates of the rules for year y in dst, which has
+ * room for one per rule, and returns their number. Substitute rules go
+ * last, in date order, so that each moves past the days already taken.
+ */
+static size_t
+expand_rules(const dt_holidays_t *h, int y, dt_t *dst) {
+    const dt_holiday_rule_t *r;
+    size_t i, n, m;
+    dt_t dt;
+
+    n = 0;
+    for (i = 0; i < h->nrules; i++) {
+        r = &h->rules[i];
+        if (r->observe == DT_OBSERVE_SUBSTITUTE)
+            continue;
+        if (rule_date(r, y, &dt))
+            dst[n++] = observe(h, r->observe, dt);
+    }
+
+    m = n;
+    for (i = 0; i < h->nrules; i++) {
+        r = &h->rules[i];
+        if (r->observe != DT_OBSERVE_SUBSTITUTE)
+            continue;
+        if (rule_date(r, y, &dt))
+            dst[m++] = dt;
+    }
+    qsort(dst + n, m - n, sizeof(dt_t), compare_dt);
+
+    for (i = n; i < m; i++) {
+        if (dt_weekend_is_weekday(&h->wk, dst[i]))
+            continue;
+        dt = dst[i];
+        do {
+            dt = dt_weekend_next_weekday(&h->wk, dt, false);
+        } while (contains(dst, m, dt));
+        dst[i] = dt;
+    }
+    return m;
+}
+
+#define MIN(x, y) (((x) < (y)) ? (x) : (y))
+#define MAX(x, y) (((x) > (y)) ? (x) : (y))
+
+/* Makes room in the window for year y, growing it by at least half */
+static bool
+reserve_year(dt_holidays_t *h, int y) {
+    year_t *years;
+    size_t grow, shift;
+    int y0, y1;
+
+    if (h->nyears && y >= h->y0 && y - h->y0 < (int)h->nyears)
+        return true;
+
+    grow = h->nyears / 2 + 8;
+    if (!h->nyears) {
+        y0 = y - (int)grow / 2;
+        y1 = y0 + (int)grow;
+    }
+    else {
+        y0 = h->y0;
+        y1 = h->y0 + (int)h->nyears;
+        if (y < y0)
+            y0 = MIN(y, y0 - (int)grow);
+        else
+            y1 = MAX(y + 1, y1 + (int)grow);
+    }
+
+    years = (year_t *)calloc((size_t)(y1 - y0), sizeof(year_t));
+    if (!years)
+        return false;
+    if (h->nyears) {
+        shift = (size_t)(h->y0 - y0);
+        memcpy(years + shift, h->years, h->nyears * sizeof(year_t));
+        free(h->years);
+    }
+    h->years  = years;
+    h->y0     = y0;
+    h->nyears = (size_t)(y1 - y0);
+    return true;
+}
+
+/* Expands year y, unless it is cached, and returns it or NULL */
+static const year_t *
+get_year(dt_holidays_t *h, int y) {
+    year_t *year;
+    dt_t first, last, dt;
+    size_t i, j, n;
+    int k;
+
+    if (!reserve_year(h, y))
+        return NULL;
+    year = &h->years[y - h->y0];
+    if (year->done)
+        return year;
+
+    first = dt_from_yd(y, 1);
+    last  = dt_from_yd(y + 1, 0);
+    n = 0;
+    for (k = -1; k <= 1; k++)
+        n += expand_rules(h, y + k, h->scratch + n);
+
+    for (i = 0, j = 0; i < n; i++) {
+        dt = h->scratch[i];
+        if (dt >= first && dt <= last && dt_weekend_is_weekday(&h->wk, dt))
+            h->scratch[j++] = dt;
+    }
+    qsort(h->scratch, j, sizeof(dt_t), compare_dt);
+    for (i = 0, n = 0; i < j; i++) {
+        if (!n || h->scratch[i] != h->scratch[n - 1])
+            h->scratch[n++] = h->scratch[i];
+    }
+
+    /* At least one entry, so that an empty year has a non-NULL array */
+    year->days = (dt_t *)malloc((n ? n : 1) * sizeof(dt_t));
+    if (!year->days)
+        return NULL;
+    memcpy(year->days, h->scratch, n * sizeof(dt_t));
+    year->n    = n;
+    year->done = true;
+    return year;
+}
+
+dt_holidays_t *
+dt_holidays_new(const dt_holiday_rule_t *rules, size_t n, unsigned int weekend) {
+    dt_holidays_t *h;
+    size_t i;
+
+    for (i = 0; i < n; i++) {
+        if (!valid_rule(&rules[i]))
+            return NULL;
+    }
+
+    h = (dt_holidays_t *)calloc(1, sizeof(*h));
+    if (!h)
+        return NULL;
+    if (!dt_weekend_init(&h->wk, weekend)) {
+        free(h);
+        return NULL;
+    }
+
+    h->nrules  = n;
+    h->rules   = (dt_holiday_rule_t *)malloc((n ? n : 1) * sizeof(dt_holiday_rule_t));
+    h->scratch = (dt_t *)malloc((n ? 3 * n : 1) * sizeof(dt_t));
+    if (!h->rules || !h->scratch) {
+        dt_holidays_free(h);
+        return NULL;
+    }
+    if (n)
+        memcpy(h->rules, rules, n * sizeof(dt_holiday_rule_t));
+    return h;
+}
+
+void
+dt_holidays_free(dt_holidays_t *h) {
+    size_t i;
+
+    if (!h)
+        return;
+    for (i = 0; i < h->nyears; i++)
+        free(h->years[i].days);
+    free(h->years);
+    free(h->rules);
+    free(h->scratch);
+    free(h);
+}
+
+const dt_t *
+dt_holidays_in_year(dt_holidays_t *h, int y, size_t *n) {
+    const year_t *year;
+
+    year = get_year(h, y);
+    if (!year)
+        return NULL;
+    if (n)
+        *n = year->n;
+    return year->days;
+}
+
+int
+dt_holidays_between(dt_holidays_t *h, dt_t first, dt_t last, dt_t *dst, size_t size) {
+    const year_t *year;
+    size_t i, count;
+    int y, y1, y2;
+
+    if (first > last)
+        return 0;
+    dt_to_yd(first, &y1, NULL);
+    dt_to_yd(last, &y2, NULL);
+
+    count = 0;
+    for (y = y1; y <= y2; y++) {
+        year = get_year(h, y);
+        if (!year)
+            return -1;
+        for (i = 0; i < year->n; i++) {
+            if (year->days[i] < first || year->days[i] > last)
+                continue;
+            if (count < size)
+                dst[count] = year->days[i];
+            count++;
+        }
+    }
+    return (int)count;
+}
+
+dt_calendar_t *
+dt_holidays_calendar(dt_holidays_t *h, dt_t first, dt_t last) {
+    dt_calendar_t *cal;
+    dt_t *days;
+    int n;
+
+    n = dt_holidays_between(h, first, last, NULL, 0);
+    if (n < 0)
+        return NULL;
+    days = (dt_t *)malloc((n ? (size_t)n : 1) * sizeof(dt_t));
+    if (!days)
+        return NULL;
+    dt_holidays_between(h, first, last, days, (size_t)n);
+    cal = dt_calendar_new(first, last, h->wk.mask, days, (size_t)n);
+    free(days);
+    return cal;
+}
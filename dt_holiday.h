@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2012-2015 Christian Hansen <chansen@cpan.org>
+ * <https://github.com/chansen/c-dt>
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met: 
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer. 
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution. 
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef __DT_HOLIDAY_H__
+#define __DT_HOLIDAY_H__
+#include <stddef.h>
+#include "dt_core.h"
+#include "dt_easter.h"
+#include "dt_calendar.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum {
+    DT_RULE_FIXED,          /* month and day of month */
+    DT_RULE_NTH_DOW,        /* nth day of the week in month, negative from the end */
+    DT_RULE_EASTER          /* offset in days from Easter Sunday */
+} dt_rule_t;
+
+typedef enum {
+    DT_OBSERVE_ACTUAL,      /* on the date itself */
+    DT_OBSERVE_NEAREST,     /* a weekend date moves to the nearest weekday */
+    DT_OBSERVE_FOLLOWING,   /* a weekend date moves to the following weekday */
+    DT_OBSERVE_PRECEDING,   /* a weekend date moves to the preceding weekday */
+    DT_OBSERVE_SUBSTITUTE   /* as following, skipping days that are already holidays */
+} dt_observe_t;
+
+typedef struct {
+    dt_rule_t     rule;
+    int           month;        /* DT_RULE_FIXED, DT_RULE_NTH_DOW */
+    int           day;          /* day of month, nth or offset from Easter */
+    dt_dow_t      dow;          /* DT_RULE_NTH_DOW */
+    dt_computus_t computus;     /* DT_RULE_EASTER */
+    dt_observe_t  observe;
+    int           first_year;   /* 0 for no lower bound */
+    int           last_year;    /* 0 for no upper bound */
+} dt_holiday_rule_t;
+
+#define DT_HOLIDAY_FIXED(m, d, observe) \
+    { DT_RULE_FIXED, (m), (d), DT_MONDAY, DT_WESTERN, (observe), 0, 0 }
+#define DT_HOLIDAY_NTH_DOW(m, nth, dow) \
+    { DT_RULE_NTH_DOW, (m), (nth), (dow), DT_WESTERN, DT_OBSERVE_ACTUAL, 0, 0 }
+#define DT_HOLIDAY_EASTER(offset, computus) \
+    { DT_RULE_EASTER, 0, (offset), DT_MONDAY, (computus), DT_OBSERVE_ACTUAL, 0, 0 }
+
+typedef struct dt_holidays dt_holidays_t;
+
+dt_holidays_t * dt_holidays_new         (const dt_holiday_rule_t *rules, size_t n,
+                                         unsigned int weekend);
+void            dt_holidays_free        (dt_holidays_t *h);
+
+const dt_t *    dt_holidays_in_year     (dt_holidays_t *h, int y, size_t *n);
+int             dt_holidays_between     (dt_holidays_t *h, dt_t first, dt_t last,
+                                         dt_t *dst, size_t size);
+
+dt_calendar_t * dt_holidays_calendar    (dt_holidays_t *h, dt_t first, dt_t last);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
+
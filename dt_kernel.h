@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) 2012-2015 Christian Hansen <chansen@cpan.org>
+ * <https://github.com/chansen/c-dt>
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met: 
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer. 
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution. 
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef __DT_KERNEL_H__
+#define __DT_KERNEL_H__
+#include <inttypes.h>
+
+/*
+ * Conversion kernels shared by the 32-bit (dt_t) and 64-bit (dt64_t) date
+ * functions. This header is private to the library.
+ */
+
+/*
+ * Returns the Rata Die day number of the ordinal date y-d, the year is
+ * normalised to a positive year using cycles of 400 years.
+ */
+static inline int64_t
+dt_kernel_rdn_from_yd(int64_t y, int64_t d) {
+    y--;
+    if (y < 0) {
+        const int64_t n400 = 1 - y/400;
+        y += n400 * 400;
+        d -= n400 * 146097;
+    }
+    return 365 * y + y/4 - y/100 + y/400 + d;
+}
+
+/*
+ * Decomposes the Rata Die day number n into the computational year, which
+ * starts on March 1, the day of the computational year [0, 365] and whether
+ * the Gregorian year y is a leap year. Based on the Euclidean affine
+ * functions described by Cassio Neri and Lorenz Schneider in "Euclidean
+ * Affine Functions and Applications to Calendar Algorithms". The day number
+ * is shifted by DT_KERNEL_K cycles of 400 years, which makes it non-negative
+ * for every year representable by an int; only the first step requires
+ * 64-bit arithmetic and every division is by a constant.
+ */
+#define DT_KERNEL_K INT64_C(5368711)
+
+static inline void
+dt_kernel_decompose(int64_t n, int64_t *yp, int *np, int *lp) {
+    uint64_t n1, p2;
+    uint32_t z;
+    uint64_t c;
+
+    n1 = 4 * (uint64_t)(n + 305 + DT_KERNEL_K * 146097) + 3;
+    c  = n1 / 146097;
+    p2 = UINT64_C(2939745) * ((uint32_t)(n1 % 146097) | 3);
+    z  = (uint32_t)(p2 >> 32);
+
+    *yp = (int64_t)(100 * c + z) - 400 * DT_KERNEL_K;
+    *np = (int)((uint32_t)p2 / 2939745 / 4);
+    *lp = (z & 3) == 0 && (z != 0 || (c & 3) == 0);
+}
+
+/*
+ * Converts the output of dt_kernel_decompose() to an ordinal date.
+ */
+static inline void
+dt_kernel_to_yd(int64_t y, int n, int l, int *yp, int *dp) {
+    const int j = n >= 306;
+    if (yp) *yp = (int)(y + j);
+    if (dp) *dp = j ? n - 305 : n + 60 + l;
+}
+
+/*
+ * Converts the output of dt_kernel_decompose() to a calendar date.
+ */
+static inline void
+dt_kernel_to_ymd(int64_t y, int n, int *yp, int *mp, int *dp) {
+    const uint32_t n3 = 2141 * (uint32_t)n + 197913;
+    const int j = n >= 306;
+    if (yp) *yp = (int)(y + j);
+    if (mp) *mp = (int)(n3 >> 16) - 12 * j;
+    if (dp) *dp = (int)((n3 & 0xFFFF) / 2141) + 1;
+}
+
+#endif
@@ -24,8 +24,10 @@
  * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  */
 #include <stddef.h>
+#include <stdint.h>
 #include "dt_core.h"
 #include "dt_valid.h"
+#include "dt64.h"
 
 static size_t
 count_digits(const unsigned char * const p, size_t i, const size_t len) {
@@ -432,6 +434,74 @@ dt_parse_iso_zone_lenient(const char *str, size_t len, int *op) {
     return n;
 }
 
+/*
+ * Fast path for the canonical extended calendar date YYYY-MM-DD. The ten
+ * bytes are assembled into two little-endian words (a single load on most
+ * targets) and the layout, the digits and the ranges of the fields are
+ * checked with word-wide operations, so that a well-formed date is decoded
+ * with a single branch. Anything else is left to the general parser.
+ */
+
+static const unsigned char days_in_month_tab[2][16] = {
+    { 0, 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31, 0, 0, 0 },
+    { 0, 31, 29, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31, 0, 0, 0 }
+};
+
+static uint64_t
+load_le64(const unsigned char *p) {
+    return (uint64_t)p[0]       | (uint64_t)p[1] <<  8 |
+           (uint64_t)p[2] << 16 | (uint64_t)p[3] << 24 |
+           (uint64_t)p[4] << 32 | (uint64_t)p[5] << 40 |
+           (uint64_t)p[6] << 48 | (uint64_t)p[7] << 56;
+}
+
+static bool
+parse_canonical_ymd(const unsigned char *p, size_t len, int *yp, int *mp, int *dp) {
+    uint64_t lo, x;
+    uint32_t hi, yd, md, dd, y, m, d, leap;
+    bool valid;
+
+    if (len < 10)
+        return false;
+
+    lo = load_le64(p);                          /* YYYY-MM- */
+    hi = (uint32_t)p[8] | (uint32_t)p[9] << 8;  /* DD */
+
+    /* Digits become 0-9 in their byte, the separators must be '-' */
+    x  = (lo ^ UINT64_C(0x3030303030303030)) & UINT64_C(0x00FFFF00FFFFFFFF);
+    hi = hi ^ 0x3030;
+    valid = (lo & UINT64_C(0xFF0000FF00000000)) == UINT64_C(0x2D00002D00000000);
+    valid &= ((x  & UINT64_C(0xF0F0F0F0F0F0F0F0)) |
+              ((x + UINT64_C(0x0606060606060606)) & UINT64_C(0xF0F0F0F0F0F0F0F0))) == 0;
+    valid &= ((hi & 0xF0F0) | ((hi + 0x0606) & 0xF0F0)) == 0;
+    /* A trailing digit makes it a different (invalid) date */
+    valid &= len == 10 || (unsigned char)(p[10] - '0') > 9;
+    if (!valid)
+        return false;
+
+    yd = (uint32_t)x;
+    md = (uint32_t)(x >> 40);
+    dd = hi;
+
+    yd = ((yd * 10) + (yd >> 8)) & 0x00FF00FF;
+    y  = ((yd * 100) + (yd >> 16)) & 0xFFFF;
+    m  = (md & 0xFF) * 10 + (md >> 8);
+    d  = (dd & 0xFF) * 10 + (dd >> 8);
+
+    leap = ((y & 3) == 0) & ((y % 100 != 0) | (y % 400 == 0));
+    valid = (m - 1 < 12) & (d - 1 < days_in_month_tab[leap][m & 15]);
+#ifndef DT_PARSE_ISO_YEAR0
+    valid &= y != 0;
+#endif
+    if (!valid)
+        return false;
+
+    *yp = (int)y;
+    *mp = (int)m;
+    *dp = (int)d;
+    return true;
+}
+
 #ifdef DT_PARSE_ISO_TNT
 /*
  * Count number of delimiting dashes, Ws or Qs in date string like
@@ -457,6 +527,13 @@ count_delims(const unsigned char *p, size_t i, size_t len) {
     return n;
 }
 #endif
+enum {
+    DATE_YD,
+    DATE_YMD,
+    DATE_YQD,
+    DATE_YWD
+};
+
 /*
  *  Basic      Extended
  *  20121224   2012-12-24   Calendar date   (ISO 8601)
@@ -464,11 +541,189 @@ count_delims(const unsigned char *p, size_t i, size_t len) {
  *  2012W521   2012-W52-1   Week date       (ISO 8601)
  *  2012Q485   2012-Q4-85   Quarter date
  *
- *  Tarantool extended ranges
- * #ifdef DT_PARSE_ISO_TNT
+ *  Expanded years (ISO 8601), extended format only
+ *  ±YYYYYYYYY-12-24
+ *  ±YYYYYYYYY-359
+ *  ±YYYYYYYYY-W52-1
+ *  ±YYYYYYYYY-Q4-85
+ *
+ *  An expanded year consists of a sign followed by 4 to width digits, a
+ *  width of zero accepts four digit years only. Stores the kind of the
+ *  date and its validated fields, returns the number of characters parsed
+ *  or 0 on error.
+ */
+static size_t
+parse_date(const unsigned char *p, size_t len, size_t width,
+           int *kp, int *yp, int *xp, int *dp) {
+    int y, x, d, sign;
+    size_t i, n;
+
+    if (parse_canonical_ymd(p, len, yp, xp, dp)) {
+        *kp = DATE_YMD;
+        return 10;
+    }
+
+    if (len < 1)
+        return 0;
+
+    sign = 0;
+    if (width) {
+        switch (p[0]) {
+            case '+':
+                sign = 1;
+                break;
+            case '-':
+                sign = -1;
+                break;
+        }
+    }
+
+    i = (sign != 0);
+    n = count_digits(p, i, len);
+    if (sign) {
+        if (n < 4 || n > width)
+            return 0;
+        y = sign * parse_number(p, i, n);
+        i += n;
+        goto extended;
+    }
+
+    switch (n) {
+        case 4: /* 2012 */
+            y = parse_number(p, 0, 4);
+            i = 4;
+            break;
+        case 7: /* 2012359 (basic ordinal date) */
+            y = parse_number(p, 0, 4);
+            d = parse_number(p, 4, 3);
+            i = 7;
+            goto yd;
+        case 8: /* 20121224 (basic calendar date) */
+            y = parse_number(p, 0, 4);
+            x = parse_number(p, 4, 2);
+            d = parse_number(p, 6, 2);
+            i = 8;
+            goto ymd;
+        default:
+            return 0;
+    }
+
+    if (i >= len)
+        return 0;
+
+    switch (p[i]) {
+        case '-':
+            break;
+#ifndef DT_PARSE_ISO_STRICT
+        case 'Q': /* 2012Q485 */
+            if (count_digits(p, i + 1, len) != 3)
+                return 0;
+            x = parse_number(p, i + 1, 1);
+            d = parse_number(p, i + 2, 2);
+            i += 4;
+            goto yqd;
+#endif
+        case 'W': /* 2012W521 */
+            if (count_digits(p, i + 1, len) != 3)
+                return 0;
+            x = parse_number(p, i + 1, 2);
+            d = parse_number(p, i + 3, 1);
+            i += 4;
+            goto ywd;
+        default:
+            return 0;
+    }
+
+  extended:
+    if (i >= len || p[i] != '-')
+        return 0;
+
+    n = count_digits(p, ++i, len);
+    switch (n) {
+        case 0: /* 2012-Q4-85 | 2012-W52-1 */
+            break;
+        case 2: /* 2012-12-24 */
+            if (i + 2 >= len || p[i + 2] != '-' || count_digits(p, i + 3, len) != 2)
+                return 0;
+            x = parse_number(p, i, 2);
+            d = parse_number(p, i + 3, 2);
+            i += 5;
+            goto ymd;
+        case 3: /* 2012-359 */
+            d = parse_number(p, i, 3);
+            i += 3;
+            goto yd;
+        default:
+            return 0;
+    }
+
+    if (i >= len)
+        return 0;
+
+    n = count_digits(p, i + 1, len);
+    switch (p[i]) {
+#ifndef DT_PARSE_ISO_STRICT
+        case 'Q': /* 2012-Q4-85 */
+            if (n != 1 || i + 2 >= len || p[i + 2] != '-' || count_digits(p, i + 3, len) != 2)
+                return 0;
+            x = parse_number(p, i + 1, 1);
+            d = parse_number(p, i + 3, 2);
+            i += 5;
+            goto yqd;
+#endif
+        case 'W': /* 2012-W52-1 */
+            if (n != 2 || i + 3 >= len || p[i + 3] != '-' || count_digits(p, i + 4, len) != 1)
+                return 0;
+            x = parse_number(p, i + 1, 2);
+            d = parse_number(p, i + 4, 1);
+            i += 5;
+            goto ywd;
+        default:
+            return 0;
+    }
+
+  yd:
+    if (!dt_valid_yd(y, d))
+        return 0;
+    *kp = DATE_YD;
+    x = 0;
+    goto finish;
+
+  ymd:
+    if (!dt_valid_ymd(y, x, d))
+        return 0;
+    *kp = DATE_YMD;
+    goto finish;
+
+#ifndef DT_PARSE_ISO_STRICT
+  yqd:
+    if (!dt_valid_yqd(y, x, d))
+        return 0;
+    *kp = DATE_YQD;
+    goto finish;
+#endif
+
+  ywd:
+    if (!dt_valid_ywd(y, x, d))
+        return 0;
+    *kp = DATE_YWD;
+
+  finish:
+#ifndef DT_PARSE_ISO_YEAR0
+    if (!sign && y < 1)
+        return 0;
+#endif
+    *yp = y;
+    *xp = x;
+    *dp = d;
+    return i;
+}
+
+#ifdef DT_PARSE_ISO_TNT
+/*
+ *  Tarantool extended ranges, in addition to the formats of parse_date()
  *  -001-12-31      0000-01-01
  *  -5879610-06-22  5879611-07-11
- * #endif
  */
 size_t
 dt_parse_iso_date(const char *str, size_t len, dt_t *dtp) {
@@ -477,21 +732,24 @@ dt_parse_iso_date(const char *str, size_t len, dt_t *dtp) {
     size_t n;
     dt_t dt;
     int head_n;
-#ifdef DT_PARSE_ISO_TNT
     int sign = +1;
     int dashes_n;
 
+    if (parse_canonical_ymd(p, len, &y, &x, &d)) {
+        if (dtp)
+            *dtp = dt_from_ymd(y, x, d);
+        return 10;
+    }
+
     if (p[0] == '-') {
         sign = -1;
         p++;
         len--;
     }
     dashes_n = count_delims(p, 0, len);
-#endif
 
     head_n = n = count_digits(p, 0, len);
     switch (n) {
-#ifdef DT_PARSE_ISO_TNT
         case 3: /* -001-01-01 | 100W521 (extended Tarantool range) */
             if (!dashes_n)
                 return 0;
@@ -516,16 +774,6 @@ dt_parse_iso_date(const char *str, size_t len, dt_t *dtp) {
             d = parse_number(p, 4, 3);
             p += 7;
             goto yd;
-#else
-        case 4: /* 2012 (year) */
-            y = parse_number(p, 0, 4);
-            break;
-        case 7: /* 2012359 (basic ordinal date) */
-            y = parse_number(p, 0, 4);
-            d = parse_number(p, 4, 3);
-            p += 7;
-            goto yd;
-#endif
         case 8: /* 20121224 (basic calendar date) */
             y = parse_number(p, 0, 4);
             x = parse_number(p, 4, 2);
@@ -608,49 +856,25 @@ dt_parse_iso_date(const char *str, size_t len, dt_t *dtp) {
     }
 
   yd:
-#ifdef DT_PARSE_ISO_TNT
     if (!dt_from_yd_checked(sign * y, d, &dt))
         return 0;
-#else
-    if (!dt_valid_yd(y, d))
-        return 0;
-    dt = dt_from_yd(y, d);
-#endif
     goto finish;
 
   ymd:
-#ifdef DT_PARSE_ISO_TNT
     if (!dt_from_ymd_checked(sign * y, x, d, &dt))
         return 0;;
-#else
-    if (!dt_valid_ymd(y, x, d))
-        return 0;
-    dt = dt_from_ymd(y, x, d);
-#endif
     goto finish;
 
 #ifndef DT_PARSE_ISO_STRICT
   yqd:
-#ifdef DT_PARSE_ISO_TNT
     if (!dt_from_yqd_checked(sign * y, x, d, &dt))
         return 0;
-#else
-    if (!dt_valid_yqd(y, x, d))
-        return 0;
-    dt = dt_from_yqd(y, x, d);
-#endif
     goto finish;
 #endif
 
   ywd:
-#ifdef DT_PARSE_ISO_TNT
     if (!dt_from_ywd_checked(sign * y, x, d, &dt))
         return 0;
-#else
-    if (!dt_valid_ywd(y, x, d))
-        return 0;
-    dt = dt_from_ywd(y, x, d);
-#endif
 
   finish:
 #ifndef DT_PARSE_ISO_YEAR0
@@ -661,6 +885,41 @@ dt_parse_iso_date(const char *str, size_t len, dt_t *dtp) {
         *dtp = dt;
     return (p - (const unsigned char *)str);
 }
+#else
+size_t
+dt_parse_iso_date(const char *str, size_t len, dt_t *dtp) {
+    int k, y, x, d;
+    size_t n;
+
+    n = parse_date((const unsigned char *)str, len, 0, &k, &y, &x, &d);
+    if (n && dtp) {
+        switch (k) {
+            case DATE_YD:  *dtp = dt_from_yd(y, d);     break;
+            case DATE_YMD: *dtp = dt_from_ymd(y, x, d); break;
+            case DATE_YQD: *dtp = dt_from_yqd(y, x, d); break;
+            case DATE_YWD: *dtp = dt_from_ywd(y, x, d); break;
+        }
+    }
+    return n;
+}
+#endif
+
+size_t
+dt64_parse_iso_date(const char *str, size_t len, dt64_t *dtp) {
+    int k, y, x, d;
+    size_t n;
+
+    n = parse_date((const unsigned char *)str, len, 9, &k, &y, &x, &d);
+    if (n && dtp) {
+        switch (k) {
+            case DATE_YD:  *dtp = dt64_from_yd(y, d);     break;
+            case DATE_YMD: *dtp = dt64_from_ymd(y, x, d); break;
+            case DATE_YQD: *dtp = dt64_from_yqd(y, x, d); break;
+            case DATE_YWD: *dtp = dt64_from_ywd(y, x, d); break;
+        }
+    }
+    return n;
+}
 
 /*
  *  Basic               Extended
@@ -710,3 +969,148 @@ dt_parse_iso_zone(const char *str, size_t len, int *offset) {
         return dt_parse_iso_zone_basic(str, len, offset);
 }
 
+
+/*
+ *  RFC 3339 profile, parsed without intermediate calls
+ *  2012-12-24T15:30:45Z
+ *  2012-12-24T15:30:45.123456789+01:00
+ *  2012-12-24 15:30:45-05:00
+ *
+ *  Returns 0 if the string is not in this exact shape, the caller then
+ *  falls back to the general parser.
+ */
+
+static size_t
+parse_rfc3339(const unsigned char *p, size_t len, dt_t *dtp, int *sp, int *fp, int *op) {
+    uint64_t t, x;
+    uint32_t hd, md, sd, h, m, s;
+    int y, mo, d, f, o, oh, om, sign;
+    size_t n;
+    bool valid;
+
+    if (len < 20 || !parse_canonical_ymd(p, len, &y, &mo, &d))
+        return 0;
+    if (p[10] != 'T' && p[10] != 't' && p[10] != ' ')
+        return 0;
+
+    t = load_le64(p + 11);                      /* hh:mm:ss */
+    x = (t ^ UINT64_C(0x3030303030303030)) & UINT64_C(0xFFFF00FFFF00FFFF);
+    valid = (t & UINT64_C(0x0000FF0000FF0000)) == UINT64_C(0x00003A00003A0000);
+    valid &= ((x  & UINT64_C(0xF0F0F0F0F0F0F0F0)) |
+              ((x + UINT64_C(0x0606060606060606)) & UINT64_C(0xF0F0F0F0F0F0F0F0))) == 0;
+    if (!valid)
+        return 0;
+
+    hd = (uint32_t)x & 0xFFFF;
+    md = (uint32_t)(x >> 24) & 0xFFFF;
+    sd = (uint32_t)(x >> 48);
+    h  = (hd & 0xFF) * 10 + (hd >> 8);
+    m  = (md & 0xFF) * 10 + (md >> 8);
+    s  = (sd & 0xFF) * 10 + (sd >> 8);
+    if ((h > 23) | (m > 59) | (s > 59))
+        return 0;
+
+    f = 0;
+    n = 19;
+    if (p[n] == '.' || p[n] == ',') {
+        size_t r = parse_fraction_digits(p, ++n, len, &f);
+        if (!r)
+            return 0;
+        n += r;
+        if (n >= len)
+            return 0;
+    }
+
+    switch (p[n]) {
+        case 'Z':
+        case 'z':
+            o = 0;
+            n += 1;
+            goto zulu;
+        case '+':
+            sign = 1;
+            break;
+        case '-':
+            sign = -1;
+            break;
+        default:
+            return 0;
+    }
+
+    if (len < n + 6 || p[n + 3] != ':' ||
+        count_digits(p, n + 1, len) != 2 || count_digits(p, n + 4, len) != 2)
+        return 0;
+
+    oh = parse_number(p, n + 1, 2);
+    om = parse_number(p, n + 4, 2);
+    if (oh > 23 || om > 59)
+        return 0;
+    o = sign * (oh * 60 + om);
+#ifdef DT_PARSE_ISO_STRICT
+    if (o == 0 && sign < 0)
+        return 0;
+#endif
+    n += 6;
+
+  zulu:
+    if (dtp) *dtp = dt_from_ymd(y, mo, d);
+    if (sp)  *sp  = (int)(h * 3600 + m * 60 + s);
+    if (fp)  *fp  = f;
+    if (op)  *op  = o;
+    return n;
+}
+
+/*
+ *  date [T time [zone]]
+ *
+ *  The date is any of the formats of dt_parse_iso_date(), the time any of
+ *  the formats of dt_parse_iso_time() and the zone any of the formats of
+ *  dt_parse_iso_zone() or a lowercase z. The date and time may also be
+ *  separated by a lowercase t or a space; a space that is not followed by
+ *  a time is not part of the date-time. The offset is 0 if the zone is
+ *  omitted.
+ */
+
+size_t
+dt_parse_iso_datetime(const char *str, size_t len, dt_t *dtp, int *sp, int *fp, int *op) {
+    const unsigned char *p = (const unsigned char *)str;
+    size_t n, r;
+    int sod, nsec, offset;
+    dt_t dt;
+
+    if ((n = parse_rfc3339(p, len, dtp, sp, fp, op)))
+        return n;
+
+    n = dt_parse_iso_date(str, len, &dt);
+    if (!n)
+        return 0;
+
+    sod = nsec = offset = 0;
+    if (n < len && (p[n] == 'T' || p[n] == 't' || p[n] == ' ')) {
+        const char *s = str + n + 1;
+        const size_t slen = len - n - 1;
+
+        if (slen > 2 && s[2] == ':')
+            r = dt_parse_iso_time_extended(s, slen, &sod, &nsec);
+        else
+            r = dt_parse_iso_time_basic(s, slen, &sod, &nsec);
+
+        if (r) {
+            n += 1 + r;
+            if (n < len && p[n] == 'z') {
+                n++;
+            }
+            else if (n < len) {
+                n += dt_parse_iso_zone(str + n, len - n, &offset);
+            }
+        }
+        else if (p[n] != ' ')
+            return 0;
+    }
+
+    if (dtp) *dtp = dt;
+    if (sp)  *sp  = sod;
+    if (fp)  *fp  = nsec;
+    if (op)  *op  = offset;
+    return n;
+}
@@ -27,12 +27,14 @@
 #define __DT_PARSE_H__
 #include <stddef.h>
 #include "dt_core.h"
+#include "dt64.h"
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
 size_t dt_parse_iso_date          (const char *str, size_t len, dt_t *dt);
+size_t dt64_parse_iso_date        (const char *str, size_t len, dt64_t *dt);
 
 size_t dt_parse_iso_time          (const char *str, size_t len, int *sod, int *nsec);
 size_t dt_parse_iso_time_basic    (const char *str, size_t len, int *sod, int *nsec);
@@ -43,6 +45,9 @@ size_t dt_parse_iso_zone_basic    (const char *str, size_t len, int *offset);
 size_t dt_parse_iso_zone_extended (const char *str, size_t len, int *offset);
 size_t dt_parse_iso_zone_lenient  (const char *str, size_t len, int *offset);
 
+size_t dt_parse_iso_datetime      (const char *str, size_t len, dt_t *dt,
+                                   int *sod, int *nsec, int *offset);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,362 @@
+/*
+ * Copyright (c) 2012-2015 Christian Hansen <chansen@cpan.org>
+ * <https://github.com/chansen/c-dt>
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met: 
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer. 
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution. 
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <stddef.h>
+#include <string.h>
+#include "dt_core.h"
+#include "dt_char.h"
+#include "dt_valid.h"
+#include "dt_parse_iso.h"
+#include "dt_zone.h"
+#include "dt_parse_pattern.h"
+
+/*
+ * A pattern is compiled into a string of opcodes ending with OP_END. Each
+ * conversion specification becomes one opcode, a numeric one selects its
+ * width, range and destination from the number table, and a literal is
+ * OP_LITERAL followed by its character. Parsing then runs the opcodes in
+ * a single switch, without looking at the pattern again.
+ */
+enum {
+    OP_END = 0,
+    OP_LITERAL,
+    OP_SPACE,
+    OP_MONTH_NAME,
+    OP_WEEKDAY_NAME,
+    OP_AMPM,
+    OP_FRACTION,
+    OP_OFFSET,
+    OP_ZONE,
+    OP_NUMBER           /* OP_NUMBER + index into number */
+};
+
+/* The values a pattern sets, a field may be set once */
+enum {
+    V_YEAR,
+    V_MONTH,
+    V_DAY,
+    V_DOY,
+    V_HOUR,
+    V_MINUTE,
+    V_SECOND,
+    V_NSEC,
+    V_WEEKDAY,
+    V_PM,
+    V_OFFSET,
+    V_COUNT
+};
+
+#define FIELD(v)        (1U << (v))
+#define FIELD_YEAR2     (1U << 16)  /* %y, the year is in the range [1969, 2068] */
+#define FIELD_HOUR12    (1U << 17)  /* %I, the hour is on a 12-hour clock */
+
+enum {
+    N_YEAR,
+    N_YEAR2,
+    N_MONTH,
+    N_DAY,
+    N_DOY,
+    N_HOUR,
+    N_HOUR12,
+    N_MINUTE,
+    N_SECOND,
+    N_WEEKDAY
+};
+
+static const struct {
+    unsigned char digits;   /* at most */
+    unsigned char value;
+    short         min;
+    short         max;
+} number[] = {
+    { 4, V_YEAR,    0, 9999 },  /* %Y */
+    { 2, V_YEAR,    0,   99 },  /* %y */
+    { 2, V_MONTH,   1,   12 },  /* %m */
+    { 2, V_DAY,     1,   31 },  /* %d %e */
+    { 3, V_DOY,     1,  366 },  /* %j */
+    { 2, V_HOUR,    0,   23 },  /* %H */
+    { 2, V_HOUR,    1,   12 },  /* %I */
+    { 2, V_MINUTE,  0,   59 },  /* %M */
+    { 2, V_SECOND,  0,   59 },  /* %S */
+    { 1, V_WEEKDAY, 1,    7 },  /* %u */
+};
+
+static const char * const month_names[12] = {
+    "january", "february", "march", "april", "may", "june",
+    "july", "august", "september", "october", "november", "december"
+};
+
+static const char * const weekday_names[7] = {
+    "monday", "tuesday", "wednesday", "thursday", "friday", "saturday", "sunday"
+};
+
+static const int pow_10[10] = {
+    1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000,
+};
+
+static size_t
+count_digits(const unsigned char * const p, size_t i, const size_t len) {
+    const size_t n = i;
+
+    for(; i < len; i++) {
+        const unsigned char c = p[i] - '0';
+        if (c > 9)
+            break;
+    }
+    return i - n;
+}
+
+static int
+parse_number(const unsigned char * const p, size_t i, size_t len) {
+    int v = 0;
+
+    for (; len; len--)
+        v = v * 10 + (p[i++] - '0');
+    return v;
+}
+
+/*
+ * An English name, in any case, either abbreviated to its first three
+ * letters or in full. Returns its index plus one.
+ */
+static size_t
+parse_name(const unsigned char *p, size_t len, const char * const *names, int count, int *vp) {
+    size_t i, n;
+    int k;
+
+    n = dt_char_span_alpha(p, len);
+    if (n < 3)
+        return 0;
+    for (k = 0; k < count; k++) {
+        if (n != 3 && n != strlen(names[k]))
+            continue;
+        for (i = 0; i < n && dt_char_to_lower(p[i]) == (unsigned char)names[k][i]; i++)
+            ;
+        if (i == n) {
+            *vp = k + 1;
+            return n;
+        }
+    }
+    return 0;
+}
+
+static bool
+emit(dt_parse_pattern_t *pat, size_t *np, unsigned char op, unsigned int fields) {
+    if (*np >= DT_PARSE_PATTERN_SIZE - 1 || (pat->fields & fields & 0xFFFF))
+        return false;
+    pat->fields |= fields;
+    pat->code[(*np)++] = op;
+    return true;
+}
+
+static bool
+emit_number(dt_parse_pattern_t *pat, size_t *np, int n, unsigned int flags) {
+    return emit(pat, np, (unsigned char)(OP_NUMBER + n), FIELD(number[n].value) | flags);
+}
+
+static bool
+compile(dt_parse_pattern_t *pat, size_t *np, const char *s) {
+    bool ok;
+
+    for (; *s; s++) {
+        if (dt_char_is_space((unsigned char)*s)) {
+            if (!emit(pat, np, OP_SPACE, 0))
+                return false;
+            continue;
+        }
+        if (*s != '%' || s[1] == '%') {
+            s += *s == '%';
+            ok = emit(pat, np, OP_LITERAL, 0) && emit(pat, np, (unsigned char)*s, 0);
+            if (!ok)
+                return false;
+            continue;
+        }
+        switch (*++s) {
+            case 'Y': ok = emit_number(pat, np, N_YEAR, 0);                 break;
+            case 'y': ok = emit_number(pat, np, N_YEAR2, FIELD_YEAR2);      break;
+            case 'm': ok = emit_number(pat, np, N_MONTH, 0);                break;
+            case 'd': ok = emit_number(pat, np, N_DAY, 0);                  break;
+            case 'e': ok = emit(pat, np, OP_SPACE, 0)
+                        && emit_number(pat, np, N_DAY, 0);                  break;
+            case 'j': ok = emit_number(pat, np, N_DOY, 0);                  break;
+            case 'H': ok = emit_number(pat, np, N_HOUR, 0);                 break;
+            case 'I': ok = emit_number(pat, np, N_HOUR12, FIELD_HOUR12);    break;
+            case 'M': ok = emit_number(pat, np, N_MINUTE, 0);               break;
+            case 'S': ok = emit_number(pat, np, N_SECOND, 0);               break;
+            case 'u': ok = emit_number(pat, np, N_WEEKDAY, 0);              break;
+            case 'b':
+            case 'B':
+            case 'h': ok = emit(pat, np, OP_MONTH_NAME, FIELD(V_MONTH));    break;
+            case 'a':
+            case 'A': ok = emit(pat, np, OP_WEEKDAY_NAME, FIELD(V_WEEKDAY)); break;
+            case 'p': ok = emit(pat, np, OP_AMPM, FIELD(V_PM));             break;
+            case 'f': ok = emit(pat, np, OP_FRACTION, FIELD(V_NSEC));       break;
+            case 'z': ok = emit(pat, np, OP_OFFSET, FIELD(V_OFFSET));       break;
+            case 'Z': ok = emit(pat, np, OP_ZONE, FIELD(V_OFFSET));         break;
+            case 'n':
+            case 't': ok = emit(pat, np, OP_SPACE, 0);                      break;
+            case 'D': ok = compile(pat, np, "%m/%d/%y");                    break;
+            case 'F': ok = compile(pat, np, "%Y-%m-%d");                    break;
+            case 'R': ok = compile(pat, np, "%H:%M");                       break;
+            case 'T': ok = compile(pat, np, "%H:%M:%S");                    break;
+            default:  ok = false;                                           break;
+        }
+        if (!ok)
+            return false;
+    }
+    return true;
+}
+
+bool
+dt_parse_pattern_compile(dt_parse_pattern_t *pat, const char *pattern) {
+    size_t n;
+
+    n = 0;
+    pat->fields = 0;
+    if (!compile(pat, &n, pattern))
+        return false;
+    if ((pat->fields & FIELD(V_DOY)) && (pat->fields & (FIELD(V_MONTH) | FIELD(V_DAY))))
+        return false;
+    if ((pat->fields & FIELD(V_PM)) && !(pat->fields & FIELD_HOUR12))
+        return false;
+    pat->code[n] = OP_END;
+    return true;
+}
+
+/*
+ * Fields missing from the pattern default to 1970-01-01T00:00:00 and a
+ * zero offset. Numbers take as many digits as there are up to their
+ * width, so patterns without separators such as %Y%m%d work.
+ */
+size_t
+dt_parse_pattern(const dt_parse_pattern_t *pat, const char *str, size_t len,
+                 dt_t *dtp, int *sodp, int *nsecp, int *offsetp) {
+    const unsigned char *p, *code;
+    const dt_zone_t *zone;
+    size_t i, n, end;
+    int v[V_COUNT];
+    int x;
+    dt_t dt;
+
+    p = (const unsigned char *)str;
+    memset(v, 0, sizeof(v));
+    v[V_YEAR]  = 1970;
+    v[V_MONTH] = 1;
+    v[V_DAY]   = 1;
+
+    for (i = 0, code = pat->code; *code != OP_END; code++) {
+        switch (*code) {
+            case OP_LITERAL:
+                if (i == len || p[i] != *++code)
+                    return 0;
+                i++;
+                break;
+            case OP_SPACE:
+                i += dt_char_span(p + i, len - i, DT_CHAR_SPACE);
+                break;
+            case OP_MONTH_NAME:
+                n = parse_name(p + i, len - i, month_names, 12, &v[V_MONTH]);
+                if (!n)
+                    return 0;
+                i += n;
+                break;
+            case OP_WEEKDAY_NAME:
+                n = parse_name(p + i, len - i, weekday_names, 7, &v[V_WEEKDAY]);
+                if (!n)
+                    return 0;
+                i += n;
+                break;
+            case OP_AMPM:
+                if (len - i < 2 || dt_char_to_lower(p[i + 1]) != 'm')
+                    return 0;
+                x = dt_char_to_lower(p[i]);
+                if (x != 'a' && x != 'p')
+                    return 0;
+                v[V_PM] = x == 'p';
+                i += 2;
+                break;
+            case OP_FRACTION:
+                n = count_digits(p, i, len);
+                if (!n)
+                    return 0;
+                x = n > 9 ? 9 : (int)n;
+                v[V_NSEC] = parse_number(p, i, x) * pow_10[9 - x];
+                i += n;
+                break;
+            case OP_OFFSET:
+                n = dt_parse_iso_zone_lenient(str + i, len - i, &v[V_OFFSET]);
+                if (!n)
+                    return 0;
+                i += n;
+                break;
+            case OP_ZONE:
+                n = dt_zone_lookup(str + i, len - i, &zone);
+                if (!n || (dt_zone_is_ambiguous(zone) && !dt_zone_is_rfc(zone)))
+                    return 0;
+                v[V_OFFSET] = dt_zone_offset(zone);
+                i += n;
+                break;
+            default:
+                x = *code - OP_NUMBER;
+                end = len - i > number[x].digits ? i + number[x].digits : len;
+                n = count_digits(p, i, end);
+                if (!n)
+                    return 0;
+                v[number[x].value] = parse_number(p, i, n);
+                if (v[number[x].value] < number[x].min || v[number[x].value] > number[x].max)
+                    return 0;
+                i += n;
+                break;
+        }
+    }
+
+    if (pat->fields & FIELD_YEAR2)
+        v[V_YEAR] += v[V_YEAR] < 69 ? 2000 : 1900;
+    if (pat->fields & FIELD_HOUR12)
+        v[V_HOUR] = v[V_HOUR] % 12 + 12 * v[V_PM];
+
+    if (pat->fields & FIELD(V_DOY)) {
+        if (!dt_valid_yd(v[V_YEAR], v[V_DOY]))
+            return 0;
+        dt = dt_from_yd(v[V_YEAR], v[V_DOY]);
+    }
+    else {
+        if (!dt_valid_ymd(v[V_YEAR], v[V_MONTH], v[V_DAY]))
+            return 0;
+        dt = dt_from_ymd(v[V_YEAR], v[V_MONTH], v[V_DAY]);
+    }
+    if ((pat->fields & FIELD(V_WEEKDAY)) && (int)dt_dow(dt) != v[V_WEEKDAY])
+        return 0;
+
+    if (dtp)
+        *dtp = dt;
+    if (sodp)
+        *sodp = v[V_HOUR] * 3600 + v[V_MINUTE] * 60 + v[V_SECOND];
+    if (nsecp)
+        *nsecp = v[V_NSEC];
+    if (offsetp)
+        *offsetp = v[V_OFFSET];
+    return i;
+}
@@ -23,7 +23,102 @@
  * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
  * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  */
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
 #include "dt_core.h"
+#include "dt_search.h"
+#include "dt_simd.h"
+
+#if defined(__GNUC__)
+#  define prefetch(p) __builtin_prefetch(p)
+#else
+#  define prefetch(p) ((void)0)
+#endif
+
+/*
+ * With SSE2 or AVX2 the bounds bisect without branches down to a window
+ * of at most SEARCH_LINEAR dates, then count the dates below the key in
+ * that window with vector compares; as the dates are sorted, the count is
+ * the offset of the bound. Holiday lists of a few dozen dates are
+ * searched in a single linear pass. Without branches the processor no
+ * longer loads ahead speculatively, so both candidates for the next
+ * probe are prefetched instead.
+ */
+#if defined(DT_SIMD_AVX2)
+#  define SEARCH_LINEAR 64
+#elif defined(DT_SIMD_SSE2)
+#  define SEARCH_LINEAR 32
+#endif
+
+#ifdef SEARCH_LINEAR
+/* Number of dates in [p, p + n) less than dt, or greater than dt if greater */
+static size_t
+count_dates(dt_t dt, const dt_t *p, size_t n, bool greater) {
+    size_t i, c;
+    __m128i acc, k4;
+
+    i = 0;
+    c = 0;
+#ifdef DT_SIMD_AVX2
+    {
+        const __m256i k8 = _mm256_set1_epi32(dt);
+        __m256i acc8 = _mm256_setzero_si256();
+
+        for (; i + 8 <= n; i += 8) {
+            const __m256i x = _mm256_loadu_si256((const __m256i *)(p + i));
+            acc8 = _mm256_sub_epi32(acc8, greater ? _mm256_cmpgt_epi32(x, k8)
+                                                  : _mm256_cmpgt_epi32(k8, x));
+        }
+        acc = _mm_add_epi32(_mm256_castsi256_si128(acc8), _mm256_extracti128_si256(acc8, 1));
+    }
+#else
+    acc = _mm_setzero_si128();
+#endif
+    k4 = _mm_set1_epi32(dt);
+    for (; i + 4 <= n; i += 4) {
+        const __m128i x = _mm_loadu_si128((const __m128i *)(p + i));
+        acc = _mm_sub_epi32(acc, greater ? _mm_cmpgt_epi32(x, k4) : _mm_cmpgt_epi32(k4, x));
+    }
+    acc = _mm_add_epi32(acc, _mm_shuffle_epi32(acc, _MM_SHUFFLE(1, 0, 3, 2)));
+    acc = _mm_add_epi32(acc, _mm_shuffle_epi32(acc, _MM_SHUFFLE(2, 3, 0, 1)));
+    c = (size_t)_mm_cvtsi128_si32(acc);
+    for (; i < n; i++)
+        c += greater ? (p[i] > dt) : (p[i] < dt);
+    return c;
+}
+
+const dt_t *
+dt_lower_bound(dt_t dt, const dt_t *lo, const dt_t *hi) {
+    size_t n, half;
+
+    n = (size_t)(hi - lo);
+    while (n > SEARCH_LINEAR) {
+        half = n / 2;
+        prefetch(lo + half / 2);
+        prefetch(lo + half + half / 2);
+        lo = (lo[half] < dt) ? lo + half : lo;
+        n -= half;
+    }
+    return lo + count_dates(dt, lo, n, false);
+}
+
+const dt_t *
+dt_upper_bound(dt_t dt, const dt_t *lo, const dt_t *hi) {
+    size_t n, half;
+
+    n = (size_t)(hi - lo);
+    while (n > SEARCH_LINEAR) {
+        half = n / 2;
+        prefetch(lo + half / 2);
+        prefetch(lo + half + half / 2);
+        lo = (lo[half] <= dt) ? lo + half : lo;
+        n -= half;
+    }
+    return lo + n - count_dates(dt, lo, n, true);
+}
+
+#else
 
 const dt_t *
 dt_lower_bound(dt_t dt, const dt_t *lo, const dt_t *hi) {
@@ -53,9 +148,184 @@ dt_upper_bound(dt_t dt, const dt_t *lo, const dt_t *hi) {
     return lo;
 }
 
+#endif
+
 bool
 dt_binary_search(dt_t dt, const dt_t *lo, const dt_t *hi) {
     lo = dt_lower_bound(dt, lo, hi);
     return (lo != hi && !(dt < *lo));
 }
 
+
+/*
+ * Exponential search outwards from hint: probes at distances 1, 2, 4, ...
+ * bracket the bound, which a binary search then finds. The cost grows
+ * with the logarithm of the distance from hint to the bound, so a hint
+ * close to the answer makes the search nearly constant time.
+ */
+const dt_t *
+dt_lower_bound_hint(dt_t dt, const dt_t *lo, const dt_t *hi, const dt_t *hint) {
+    size_t step;
+
+    if (hint < lo)
+        hint = lo;
+    else if (hint > hi)
+        hint = hi;
+
+    if (hint < hi && *hint < dt) {
+        lo = hint + 1;
+        for (step = 1; step <= (size_t)(hi - lo); step *= 2) {
+            if (lo[step - 1] >= dt) {
+                hi = lo + step - 1;
+                break;
+            }
+            lo += step;
+        }
+    }
+    else {
+        hi = hint;
+        for (step = 1; step <= (size_t)(hi - lo); step *= 2) {
+            if (hi[-(ptrdiff_t)step] < dt) {
+                lo = hi - step + 1;
+                break;
+            }
+            hi -= step;
+        }
+    }
+    return dt_lower_bound(dt, lo, hi);
+}
+
+/*
+ * Each key is searched from the bound of the previous one, so sorted keys
+ * are merged with the dates in time proportional to the number of keys
+ * times the logarithm of the average gap between their bounds.
+ */
+void
+dt_lower_bound_n(const dt_t *keys, size_t n, const dt_t *first, const dt_t *last, size_t *dst) {
+    const dt_t *p;
+    size_t i;
+
+    p = first;
+    for (i = 0; i < n; i++) {
+        p = dt_lower_bound_hint(keys[i], first, last, p);
+        dst[i] = (size_t)(p - first);
+    }
+}
+
+/*
+ * A search index holds the dates in Eytzinger order: the sorted array
+ * laid out as an implicit binary tree in breadth first order, with the
+ * root at tree[1] and the children of tree[k] at tree[2k] and tree[2k+1].
+ * A search descends from the root with k = 2k + (tree[k] < dt), which
+ * compiles to a conditional move instead of a branch, and the nodes
+ * visited first share a few cache lines. Sixteen dates fill a 64 byte
+ * line, so the grandchildren four levels down, tree[16k] through
+ * tree[16k+15], are prefetched while the current level is compared.
+ * rank[k] is the position of tree[k] in the sorted array.
+ */
+struct dt_search_index {
+    size_t    n;
+    dt_t     *tree;
+    uint32_t *rank;
+};
+
+#if defined(__GNUC__)
+#  define ctz(x) ((int)__builtin_ctzll(x))
+#else
+static int
+ctz(unsigned long long x) {
+    int n = 0;
+    while (!(x & 1)) {
+        x >>= 1;
+        n++;
+    }
+    return n;
+}
+#endif
+
+/* Fills the subtree at k in order from first and returns the next position */
+static size_t
+eytzinger(dt_search_index_t *idx, const dt_t *first, size_t i, size_t k) {
+    if (k <= idx->n) {
+        i = eytzinger(idx, first, i, 2 * k);
+        idx->tree[k] = first[i];
+        idx->rank[k] = (uint32_t)i;
+        i = eytzinger(idx, first, i + 1, 2 * k + 1);
+    }
+    return i;
+}
+
+dt_search_index_t *
+dt_search_index_new(const dt_t *first, const dt_t *last) {
+    dt_search_index_t *idx;
+    size_t n;
+
+    n = (size_t)(last - first);
+    if (n > UINT32_MAX)
+        return NULL;
+
+    idx = (dt_search_index_t *)malloc(sizeof(*idx));
+    if (!idx)
+        return NULL;
+    idx->n    = n;
+    idx->tree = (dt_t *)malloc((n + 1) * sizeof(dt_t));
+    idx->rank = (uint32_t *)malloc((n + 1) * sizeof(uint32_t));
+    if (!idx->tree || !idx->rank) {
+        dt_search_index_free(idx);
+        return NULL;
+    }
+    idx->tree[0] = 0;
+    idx->rank[0] = (uint32_t)n;
+    eytzinger(idx, first, 0, 1);
+    return idx;
+}
+
+void
+dt_search_index_free(dt_search_index_t *idx) {
+    if (!idx)
+        return;
+    free(idx->tree);
+    free(idx->rank);
+    free(idx);
+}
+
+/*
+ * After the descent, k encodes the path taken: the search went right at
+ * each trailing one bit, and the answer is the node where it last went
+ * left. Shifting out the trailing ones and that left turn yields it, or
+ * 0 (rank n) when the search went right all the way down.
+ */
+#define EYTZINGER_DESCEND(idx, k, cmp) do {                         \
+    const dt_t *tree = (idx)->tree;                                 \
+    const size_t n = (idx)->n;                                      \
+    k = 1;                                                          \
+    while (k <= n) {                                                \
+        prefetch(tree + (16 * k <= n ? 16 * k : 0));                \
+        k = 2 * k + (tree[k] cmp dt);                               \
+    }                                                               \
+    k >>= ctz(~(unsigned long long)k) + 1;                          \
+} while (0)
+
+size_t
+dt_search_index_lower_bound(const dt_search_index_t *idx, dt_t dt) {
+    size_t k;
+
+    EYTZINGER_DESCEND(idx, k, <);
+    return idx->rank[k];
+}
+
+size_t
+dt_search_index_upper_bound(const dt_search_index_t *idx, dt_t dt) {
+    size_t k;
+
+    EYTZINGER_DESCEND(idx, k, <=);
+    return idx->rank[k];
+}
+
+bool
+dt_search_index_contains(const dt_search_index_t *idx, dt_t dt) {
+    size_t k;
+
+    EYTZINGER_DESCEND(idx, k, <);
+    return k && idx->tree[k] == dt;
+}
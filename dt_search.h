@@ -25,16 +25,29 @@
  */
 #ifndef __DT_SEARCH_H__
 #define __DT_SEARCH_H__
+#include <stddef.h>
 #include "dt_core.h"
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+typedef struct dt_search_index dt_search_index_t;
+
 const dt_t *  dt_lower_bound    (dt_t dt, const dt_t *first, const dt_t *last);
 const dt_t *  dt_upper_bound    (dt_t dt, const dt_t *first, const dt_t *last);
 bool          dt_binary_search  (dt_t dt, const dt_t *first, const dt_t *last);
 
+const dt_t *  dt_lower_bound_hint   (dt_t dt, const dt_t *first, const dt_t *last, const dt_t *hint);
+void          dt_lower_bound_n      (const dt_t *keys, size_t n, const dt_t *first, const dt_t *last,
+                                     size_t *dst);
+
+dt_search_index_t * dt_search_index_new         (const dt_t *first, const dt_t *last);
+void                dt_search_index_free        (dt_search_index_t *idx);
+size_t              dt_search_index_lower_bound (const dt_search_index_t *idx, dt_t dt);
+size_t              dt_search_index_upper_bound (const dt_search_index_t *idx, dt_t dt);
+bool                dt_search_index_contains    (const dt_search_index_t *idx, dt_t dt);
+
 #ifdef __cplusplus
 }
 #endif
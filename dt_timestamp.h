@@ -0,0 +1,159 @@
+/*
+ * Copyright (c) 2012-2015 Christian Hansen <chansen@cpan.org>
+ * <https://github.com/chansen/c-dt>
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met: 
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer. 
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution. 
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef __DT_TIMESTAMP_H__
+#define __DT_TIMESTAMP_H__
+#include <stdint.h>
+#include "dt_core.h"
+#include "dt64.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * An instant, the number of seconds since 1970-01-01T00:00:00Z (the Unix
+ * epoch) and the nanoseconds within the second. A normalized timestamp has
+ * nsec in the range [0, 999999999], for instants before the epoch sec is
+ * negative and nsec still counts forward.
+ */
+typedef struct {
+    int64_t sec;
+    int32_t nsec;
+} dt_timestamp_t;
+
+#define DT_SECS_PER_DAY     86400
+#define DT_NSECS_PER_SEC    1000000000
+
+/* 1970-01-01 */
+#define DT_TIMESTAMP_EPOCH  (719163 + DT_EPOCH_OFFSET)
+
+/*
+ * The functions are defined in the header so that the compiler can inline
+ * them; none of them branches on the sign of its arguments and each
+ * performs at most one division, by a constant.
+ */
+
+DT_INLINE dt_timestamp_t
+dt_timestamp_from_dt64(dt64_t dt, int sod, int nsec) {
+    dt_timestamp_t ts;
+
+    ts.sec  = (dt - DT_TIMESTAMP_EPOCH) * DT_SECS_PER_DAY + sod;
+    ts.nsec = nsec;
+    return ts;
+}
+
+DT_INLINE dt_timestamp_t
+dt_timestamp_from_dt(dt_t dt, int sod, int nsec) {
+    return dt_timestamp_from_dt64(dt, sod, nsec);
+}
+
+DT_INLINE void
+dt_timestamp_to_dt64(dt_timestamp_t ts, dt64_t *dtp, int *sodp, int *nsecp) {
+    int64_t days, sod, neg;
+
+    days = ts.sec / DT_SECS_PER_DAY;
+    sod  = ts.sec % DT_SECS_PER_DAY;
+    neg  = -(int64_t)(sod < 0);
+    days += neg;
+    sod  += neg & DT_SECS_PER_DAY;
+
+    if (dtp)   *dtp   = days + DT_TIMESTAMP_EPOCH;
+    if (sodp)  *sodp  = (int)sod;
+    if (nsecp) *nsecp = ts.nsec;
+}
+
+DT_INLINE void
+dt_timestamp_to_dt(dt_timestamp_t ts, dt_t *dtp, int *sodp, int *nsecp) {
+    dt64_t dt;
+
+    dt_timestamp_to_dt64(ts, &dt, sodp, nsecp);
+    if (dtp) *dtp = (dt_t)dt;
+}
+
+DT_INLINE dt_timestamp_t
+dt_timestamp_normalize(int64_t sec, int64_t nsec) {
+    dt_timestamp_t ts;
+    int64_t q, r, neg;
+
+    q   = nsec / DT_NSECS_PER_SEC;
+    r   = nsec % DT_NSECS_PER_SEC;
+    neg = -(int64_t)(r < 0);
+    ts.sec  = sec + q + neg;
+    ts.nsec = (int32_t)(r + (neg & DT_NSECS_PER_SEC));
+    return ts;
+}
+
+/*
+ * Adds sec seconds and nsec nanoseconds to the normalized timestamp ts,
+ * nsec must be in the range [-999999999, 999999999].
+ */
+DT_INLINE dt_timestamp_t
+dt_timestamp_add(dt_timestamp_t ts, int64_t sec, int32_t nsec) {
+    int32_t n, hi, lo;
+
+    n  = ts.nsec + nsec;
+    hi = n >= DT_NSECS_PER_SEC;
+    lo = n < 0;
+    ts.sec += sec + hi - lo;
+    ts.nsec = n + (lo - hi) * DT_NSECS_PER_SEC;
+    return ts;
+}
+
+DT_INLINE dt_timestamp_t
+dt_timestamp_sub(dt_timestamp_t ts, int64_t sec, int32_t nsec) {
+    return dt_timestamp_add(ts, -sec, -nsec);
+}
+
+DT_INLINE dt_timestamp_t
+dt_timestamp_add_nsec(dt_timestamp_t ts, int64_t nsec) {
+    return dt_timestamp_add(ts, nsec / DT_NSECS_PER_SEC,
+                            (int32_t)(nsec % DT_NSECS_PER_SEC));
+}
+
+/*
+ * The difference end - start of two normalized timestamps, the nanoseconds
+ * of the result are in the range [0, 999999999].
+ */
+DT_INLINE void
+dt_timestamp_delta(dt_timestamp_t start, dt_timestamp_t end, int64_t *secp, int32_t *nsecp) {
+    int32_t n, lo;
+
+    n  = end.nsec - start.nsec;
+    lo = n < 0;
+    if (secp)  *secp  = end.sec - start.sec - lo;
+    if (nsecp) *nsecp = n + lo * DT_NSECS_PER_SEC;
+}
+
+DT_INLINE int
+dt_timestamp_compare(dt_timestamp_t a, dt_timestamp_t b) {
+    return a.sec != b.sec ? (a.sec > b.sec) - (a.sec < b.sec)
+                          : (a.nsec > b.nsec) - (a.nsec < b.nsec);
+}
+
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -0,0 +1,748 @@
+/*
+ * Copyright (c) 2012-2015 Christian Hansen <chansen@cpan.org>
+ * <https://github.com/chansen/c-dt>
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met: 
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer. 
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution. 
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "dt_core.h"
+#include "dt_accessor.h"
+#include "dt_char.h"
+#include "dt_dow.h"
+#include "dt_util.h"
+#include "dt_timestamp.h"
+#include "dt_tz.h"
+
+/*
+ * A zone is the list of its transitions and the local time type of each
+ * interval between them: interval i runs from transition i - 1 up to
+ * transition i, the first interval has no start and the last no end. The
+ * rule in the footer of a version 2 or later file is expanded into more
+ * transitions when the zone is loaded, so a zone is never modified once
+ * loaded and threads may share it, each with its own cached interval.
+ */
+typedef struct {
+    int32_t offset;
+    bool    dst;
+    size_t  abbr;       /* index into abbrs */
+} ttype_t;
+
+struct dt_tz {
+    size_t          n;              /* number of transitions */
+    int64_t        *times;          /* n ascending transitions */
+    unsigned short *types;          /* n + 1 intervals */
+    ttype_t        *ttypes;
+    size_t          ntypes;
+    char           *abbrs;
+    size_t          nabbrs;
+    int32_t         max_offset;     /* largest absolute offset */
+};
+
+typedef struct {
+    int     version;
+    size_t  isutcnt;
+    size_t  isstdcnt;
+    size_t  leapcnt;
+    size_t  timecnt;
+    size_t  typecnt;
+    size_t  charcnt;
+} header_t;
+
+#define HEADER_SIZE 44
+
+static uint32_t
+load32(const unsigned char *p) {
+    return (uint32_t)p[0] << 24 | (uint32_t)p[1] << 16 | (uint32_t)p[2] << 8 | p[3];
+}
+
+static int64_t
+load32s(const unsigned char *p) {
+    uint32_t v = load32(p);
+
+    return (int64_t)v - ((int64_t)(v & 0x80000000U) << 1);
+}
+
+static int64_t
+load64s(const unsigned char *p) {
+    uint64_t v = (uint64_t)load32(p) << 32 | load32(p + 4);
+
+    return v >> 63 ? -(int64_t)(~v) - 1 : (int64_t)v;
+}
+
+static bool
+parse_header(const unsigned char *p, size_t len, header_t *h) {
+    if (len < HEADER_SIZE || memcmp(p, "TZif", 4) != 0)
+        return false;
+    if (p[4] == 0)
+        h->version = 1;
+    else if (p[4] >= '2' && p[4] <= '9')
+        h->version = p[4] - '0';
+    else
+        return false;
+    h->isutcnt  = load32(p + 20);
+    h->isstdcnt = load32(p + 24);
+    h->leapcnt  = load32(p + 28);
+    h->timecnt  = load32(p + 32);
+    h->typecnt  = load32(p + 36);
+    h->charcnt  = load32(p + 40);
+    return h->typecnt >= 1 && h->typecnt <= 256 && h->charcnt >= 1
+        && (h->isutcnt == 0 || h->isutcnt == h->typecnt)
+        && (h->isstdcnt == 0 || h->isstdcnt == h->typecnt)
+        && h->timecnt <= len && h->leapcnt <= len && h->charcnt <= len;
+}
+
+static size_t
+data_size(const header_t *h, size_t timesize) {
+    return h->timecnt * timesize + h->timecnt + h->typecnt * 6 + h->charcnt
+         + h->leapcnt * (timesize + 4) + h->isstdcnt + h->isutcnt;
+}
+
+/*
+ * The footer is a POSIX TZ string such as "EST5EDT,M3.2.0,M11.1.0" or
+ * "<+1030>-10:30<+11>-11,M10.1.0,M4.1.0". Offsets in the string are west
+ * of UTC and are negated here. A rule is a day of the year counting from
+ * one without February 29 (Jn), from zero (n), or the nth day of the week
+ * in a month (Mm.n.d), followed by a local time that defaults to 02:00.
+ */
+typedef struct {
+    int     kind;       /* 'J', 'D' or 'M' */
+    int     month;
+    int     week;
+    int     day;
+    int32_t time;
+} rule_t;
+
+typedef struct {
+    const unsigned char *name[2];   /* standard and daylight saving time */
+    size_t               len[2];
+    int32_t              offset[2];
+    rule_t               rule[2];   /* start and end of daylight saving time */
+    bool                 has_dst;
+} posix_t;
+
+static const unsigned char *
+parse_int(const unsigned char *p, const unsigned char *e, int min, int max, int *vp) {
+    const unsigned char *s;
+    int v;
+
+    v = 0;
+    for (s = p; p < e && p - s < 3 && dt_char_is_digit(*p); p++)
+        v = v * 10 + (*p - '0');
+    if (p == s || v < min || v > max)
+        return NULL;
+    *vp = v;
+    return p;
+}
+
+static const unsigned char *
+parse_name(const unsigned char *p, const unsigned char *e, const unsigned char **name, size_t *len) {
+    size_t n;
+
+    if (p < e && *p == '<') {
+        for (n = 1; p + n < e && p[n] != '>'; n++)
+            ;
+        if (p + n == e || n < 4)
+            return NULL;
+        *name = p + 1;
+        *len  = n - 1;
+        return p + n + 1;
+    }
+    n = dt_char_span_alpha(p, (size_t)(e - p));
+    if (n < 3)
+        return NULL;
+    *name = p;
+    *len  = n;
+    return p + n;
+}
+
+/* [+|-]hh[:mm[:ss]], with up to 167 hours */
+static const unsigned char *
+parse_time(const unsigned char *p, const unsigned char *e, int32_t *vp) {
+    int h, m, s, sign;
+
+    sign = 1;
+    if (p < e && (*p == '+' || *p == '-'))
+        sign = *p++ == '-' ? -1 : 1;
+    m = s = 0;
+    p = parse_int(p, e, 0, 167, &h);
+    if (p && p < e && *p == ':') {
+        p = parse_int(p + 1, e, 0, 59, &m);
+        if (p && p < e && *p == ':')
+            p = parse_int(p + 1, e, 0, 59, &s);
+    }
+    if (p)
+        *vp = sign * (h * 3600 + m * 60 + s);
+    return p;
+}
+
+static const unsigned char *
+parse_rule(const unsigned char *p, const unsigned char *e, rule_t *r) {
+    if (p == e)
+        return NULL;
+    if (*p == 'J') {
+        r->kind = 'J';
+        p = parse_int(p + 1, e, 1, 365, &r->day);
+    }
+    else if (*p == 'M') {
+        r->kind = 'M';
+        p = parse_int(p + 1, e, 1, 12, &r->month);
+        if (p && p < e && *p == '.')
+            p = parse_int(p + 1, e, 1, 5, &r->week);
+        else
+            p = NULL;
+        if (p && p < e && *p == '.')
+            p = parse_int(p + 1, e, 0, 6, &r->day);
+        else
+            p = NULL;
+    }
+    else {
+        r->kind = 'D';
+        p = parse_int(p, e, 0, 365, &r->day);
+    }
+    r->time = 7200;
+    if (p && p < e && *p == '/')
+        p = parse_time(p + 1, e, &r->time);
+    return p;
+}
+
+static bool
+parse_posix(const unsigned char *p, const unsigned char *e, posix_t *tz) {
+    int32_t off;
+
+    p = parse_name(p, e, &tz->name[0], &tz->len[0]);
+    if (!p || !(p = parse_time(p, e, &off)))
+        return false;
+    tz->offset[0] = -off;
+    tz->has_dst = false;
+    tz->len[1] = 0;
+    if (p == e)
+        return true;
+
+    p = parse_name(p, e, &tz->name[1], &tz->len[1]);
+    if (!p)
+        return false;
+    tz->has_dst = true;
+    tz->offset[1] = tz->offset[0] + 3600;
+    if (p < e && *p != ',') {
+        if (!(p = parse_time(p, e, &off)))
+            return false;
+        tz->offset[1] = -off;
+    }
+    if (p == e) {
+        /* The rules of the United States, as POSIX leaves the default to the implementation */
+        tz->rule[0].kind  = tz->rule[1].kind  = 'M';
+        tz->rule[0].month = 3;
+        tz->rule[0].week  = 2;
+        tz->rule[1].month = 11;
+        tz->rule[1].week  = 1;
+        tz->rule[0].day   = tz->rule[1].day  = 0;
+        tz->rule[0].time  = tz->rule[1].time = 7200;
+        return true;
+    }
+    if (*p != ',' || !(p = parse_rule(p + 1, e, &tz->rule[0])))
+        return false;
+    if (p == e || *p != ',' || !(p = parse_rule(p + 1, e, &tz->rule[1])))
+        return false;
+    return p == e;
+}
+
+/* The instant a rule takes effect in year y, from the local offset before it */
+static int64_t
+rule_instant(const rule_t *r, int y, int32_t offset) {
+    dt_t dt;
+
+    if (r->kind == 'J')
+        dt = dt_from_yd(y, r->day) + (r->day >= 60 && dt_leap_year(y));
+    else if (r->kind == 'D')
+        dt = dt_from_yd(y, 1) + r->day;
+    else
+        dt = dt_nth_dow_in_month(dt_from_ymd(y, r->month, 1), r->week == 5 ? -1 : r->week,
+                                 r->day ? (dt_dow_t)r->day : DT_SUNDAY);
+    return dt_timestamp_from_dt(dt, 0, 0).sec + r->time - offset;
+}
+
+/* Returns the index of a type with the given offset, flag and name, adding one if needed */
+static size_t
+find_type(dt_tz_t *tz, int32_t offset, bool dst, const unsigned char *name, size_t len) {
+    size_t i;
+
+    for (i = 0; i < tz->ntypes; i++) {
+        if (tz->ttypes[i].offset == offset && tz->ttypes[i].dst == dst
+            && strlen(tz->abbrs + tz->ttypes[i].abbr) == len
+            && memcmp(tz->abbrs + tz->ttypes[i].abbr, name, len) == 0)
+            return i;
+    }
+    tz->ttypes[i].offset = offset;
+    tz->ttypes[i].dst    = dst;
+    tz->ttypes[i].abbr   = tz->nabbrs;
+    memcpy(tz->abbrs + tz->nabbrs, name, len);
+    tz->abbrs[tz->nabbrs + len] = 0;
+    tz->nabbrs += len + 1;
+    return tz->ntypes++;
+}
+
+/*
+ * Appends a transition at t to the type. A transition before the last
+ * one is dropped, one at the same instant replaces it, and one to the
+ * type already in effect is not needed.
+ */
+static void
+push_transition(dt_tz_t *tz, int64_t t, size_t type) {
+    if (tz->n && t <= tz->times[tz->n - 1]) {
+        if (t < tz->times[tz->n - 1])
+            return;
+        tz->n--;
+    }
+    if (tz->types[tz->n] == type)
+        return;
+    tz->times[tz->n] = t;
+    tz->types[++tz->n] = (unsigned short)type;
+}
+
+/*
+ * Transition times are limited to this many seconds from the epoch, which
+ * allows the -2^59 that zic writes for the start of time but keeps far
+ * enough from the limits of int64_t that adding an offset cannot overflow.
+ */
+#define TIME_LIMIT ((int64_t)1 << 60)
+
+/*
+ * Expands the rule from the year of the last transition, or from 1970 if
+ * there is none, through DT_TZ_LAST_YEAR.
+ */
+static bool
+expand_posix(dt_tz_t *tz, const posix_t *posix) {
+    size_t std, dst, maxn;
+    int64_t t0, t1;
+    int y, y0;
+    void *p;
+
+    std = find_type(tz, posix->offset[0], false, posix->name[0], posix->len[0]);
+    if (!posix->has_dst) {
+        if (tz->n == 0)
+            tz->types[0] = (unsigned short)std;
+        return true;
+    }
+    dst = find_type(tz, posix->offset[1], true, posix->name[1], posix->len[1]);
+
+    y0 = 1970;
+    if (tz->n) {
+        dt_timestamp_t ts;
+        dt_t dt;
+
+        ts.sec  = tz->times[tz->n - 1];
+        ts.nsec = 0;
+        if (ts.sec < -((int64_t)1 << 40))
+            ts.sec = -((int64_t)1 << 40);
+        else if (ts.sec > ((int64_t)1 << 40))
+            ts.sec = (int64_t)1 << 40;
+        dt_timestamp_to_dt(ts, &dt, NULL, NULL);
+        y0 = dt_year(dt);
+        if (y0 < 1900)
+            y0 = 1900;
+    }
+    if (y0 > DT_TZ_LAST_YEAR)
+        return true;
+
+    maxn = tz->n + 2 * (size_t)(DT_TZ_LAST_YEAR - y0 + 1);
+    if (!(p = realloc(tz->times, maxn * sizeof(int64_t))))
+        return false;
+    tz->times = (int64_t *)p;
+    if (!(p = realloc(tz->types, (maxn + 1) * sizeof(unsigned short))))
+        return false;
+    tz->types = (unsigned short *)p;
+
+    for (y = y0; y <= DT_TZ_LAST_YEAR; y++) {
+        t0 = rule_instant(&posix->rule[0], y, posix->offset[0]);
+        t1 = rule_instant(&posix->rule[1], y, posix->offset[1]);
+        if (t0 < t1) {
+            push_transition(tz, t0, dst);
+            push_transition(tz, t1, std);
+        }
+        else {
+            push_transition(tz, t1, std);
+            push_transition(tz, t0, dst);
+        }
+    }
+    return true;
+}
+
+static int32_t
+type_offset(const dt_tz_t *tz, size_t k) {
+    return tz->ttypes[tz->types[k]].offset;
+}
+
+dt_tz_t *
+dt_tz_parse(const unsigned char *src, size_t len) {
+    const unsigned char *p, *e, *end, *ttinfo;
+    header_t h;
+    posix_t posix;
+    bool has_posix;
+    size_t i, size, timesize;
+    int32_t offset;
+    dt_tz_t *tz;
+
+    if (!parse_header(src, len, &h))
+        return NULL;
+    end = src + len;
+    p = src + HEADER_SIZE;
+    timesize = 4;
+    if (h.version >= 2) {
+        size = data_size(&h, 4);
+        if (size > (size_t)(end - p))
+            return NULL;
+        p += size;
+        if (!parse_header(p, (size_t)(end - p), &h))
+            return NULL;
+        p += HEADER_SIZE;
+        timesize = 8;
+    }
+    size = data_size(&h, timesize);
+    if (size > (size_t)(end - p))
+        return NULL;
+
+    has_posix = false;
+    e = p + size;
+    if (h.version >= 2 && e < end && *e == '\n') {
+        const unsigned char *s = ++e;
+
+        while (e < end && *e != '\n')
+            e++;
+        if (e == end)
+            return NULL;
+        if (e > s) {
+            if (!parse_posix(s, e, &posix))
+                return NULL;
+            has_posix = true;
+        }
+    }
+
+    tz = (dt_tz_t *)calloc(1, sizeof(*tz));
+    if (!tz)
+        return NULL;
+    tz->times  = (int64_t *)malloc((h.timecnt ? h.timecnt : 1) * sizeof(int64_t));
+    tz->types  = (unsigned short *)malloc((h.timecnt + 1) * sizeof(unsigned short));
+    tz->ttypes = (ttype_t *)malloc((h.typecnt + 2) * sizeof(ttype_t));
+    tz->abbrs  = (char *)malloc(h.charcnt + 1 + (has_posix ? posix.len[0] + posix.len[1] + 2 : 0));
+    if (!tz->times || !tz->types || !tz->ttypes || !tz->abbrs)
+        goto error;
+
+    ttinfo = p + h.timecnt * (timesize + 1);
+    for (i = 0; i < h.typecnt; i++) {
+        const unsigned char *t = ttinfo + i * 6;
+
+        if (load32(t) == 0x80000000U || t[4] > 1 || t[5] >= h.charcnt)
+            goto error;
+        tz->ttypes[i].offset = (int32_t)load32s(t);
+        tz->ttypes[i].dst    = t[4] != 0;
+        tz->ttypes[i].abbr   = t[5];
+    }
+    tz->ntypes = h.typecnt;
+    memcpy(tz->abbrs, ttinfo + h.typecnt * 6, h.charcnt);
+    tz->abbrs[h.charcnt] = 0;
+    tz->nabbrs = h.charcnt + 1;
+
+    tz->types[0] = 0;
+    for (i = 0; i < h.timecnt; i++) {
+        tz->times[i] = timesize == 8 ? load64s(p + i * 8) : load32s(p + i * 4);
+        tz->types[i + 1] = p[h.timecnt * timesize + i];
+        if (tz->types[i + 1] >= h.typecnt || (i && tz->times[i] <= tz->times[i - 1])
+            || tz->times[i] < -TIME_LIMIT || tz->times[i] > TIME_LIMIT)
+            goto error;
+    }
+    tz->n = h.timecnt;
+
+    if (has_posix && !expand_posix(tz, &posix))
+        goto error;
+
+    for (i = 0; i <= tz->n; i++) {
+        offset = type_offset(tz, i);
+        if (offset < 0)
+            offset = -offset;
+        if (offset > tz->max_offset)
+            tz->max_offset = offset;
+    }
+    return tz;
+
+  error:
+    dt_tz_free(tz);
+    return NULL;
+}
+
+dt_tz_t *
+dt_tz_load(const char *name) {
+    unsigned char *buf, *tmp;
+    size_t len, size, n;
+    char path[1024];
+    dt_tz_t *tz;
+    FILE *fp;
+
+    if (name[0] == '/') {
+        if (strlen(name) >= sizeof(path))
+            return NULL;
+        strcpy(path, name);
+    }
+    else {
+        /* A relative name must stay within the zoneinfo directory */
+        if (strstr(name, "..") || strlen(DT_TZ_DIR) + strlen(name) + 2 > sizeof(path))
+            return NULL;
+        sprintf(path, "%s/%s", DT_TZ_DIR, name);
+    }
+
+    fp = fopen(path, "rb");
+    if (!fp)
+        return NULL;
+    len = 0;
+    size = 4096;
+    buf = (unsigned char *)malloc(size);
+    while (buf) {
+        n = fread(buf + len, 1, size - len, fp);
+        len += n;
+        if (len < size)
+            break;
+        size *= 2;
+        tmp = (unsigned char *)realloc(buf, size);
+        if (!tmp)
+            free(buf);
+        buf = tmp;
+    }
+    tz = NULL;
+    if (buf && !ferror(fp))
+        tz = dt_tz_parse(buf, len);
+    fclose(fp);
+    free(buf);
+    return tz;
+}
+
+void
+dt_tz_free(dt_tz_t *tz) {
+    if (!tz)
+        return;
+    free(tz->times);
+    free(tz->types);
+    free(tz->ttypes);
+    free(tz->abbrs);
+    free(tz);
+}
+
+/* The number of transitions at or before utc, which is within [lo, hi] */
+static size_t
+search_interval(const dt_tz_t *tz, int64_t utc, size_t lo, size_t hi) {
+    size_t mid;
+
+    while (lo < hi) {
+        mid = lo + (hi - lo) / 2;
+        if (tz->times[mid] <= utc)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    return lo;
+}
+
+/* The interval utc falls in */
+static size_t
+find_interval(const dt_tz_t *tz, int64_t utc) {
+    return search_interval(tz, utc, 0, tz->n);
+}
+
+/* As find_interval(), searching outwards from interval k with growing steps */
+static size_t
+find_interval_from(const dt_tz_t *tz, int64_t utc, size_t k) {
+    size_t lo, hi, step;
+
+    lo = 0;
+    hi = tz->n;
+    if (k < tz->n && tz->times[k] <= utc) {
+        for (lo = k + 1, step = 1; lo + step - 1 < tz->n; step *= 2) {
+            if (tz->times[lo + step - 1] > utc) {
+                hi = lo + step - 1;
+                break;
+            }
+            lo += step;
+        }
+    }
+    else {
+        for (hi = k, step = 1; step <= hi; step *= 2) {
+            if (tz->times[hi - step] <= utc) {
+                lo = hi - step + 1;
+                break;
+            }
+            hi -= step;
+        }
+    }
+    return search_interval(tz, utc, lo, hi);
+}
+
+/*
+ * The local times of interval k that no other interval has: those after
+ * the local end of every earlier interval and before the local start of
+ * every later one. Only intervals within the largest offset of the ends
+ * of interval k can reach into it.
+ */
+static void
+fill_interval(const dt_tz_t *tz, size_t k, dt_tz_interval_t *iv) {
+    const ttype_t *t;
+    int64_t v;
+    size_t j;
+
+    t = &tz->ttypes[tz->types[k]];
+    iv->tz     = tz;
+    iv->offset = t->offset;
+    iv->dst    = t->dst;
+    iv->abbr   = tz->abbrs + t->abbr;
+
+    if (k == 0)
+        iv->start = iv->local_start = INT64_MIN;
+    else {
+        iv->start = tz->times[k - 1];
+        iv->local_start = iv->start + t->offset;
+        for (j = k; j > 0 && tz->times[j - 1] + tz->max_offset > iv->local_start; j--) {
+            v = tz->times[j - 1] + type_offset(tz, j - 1);
+            if (v > iv->local_start)
+                iv->local_start = v;
+        }
+    }
+
+    if (k == tz->n)
+        iv->end = iv->local_end = INT64_MAX;
+    else {
+        iv->end = tz->times[k];
+        iv->local_end = iv->end + t->offset;
+        for (j = k + 1; j <= tz->n && tz->times[j - 1] - tz->max_offset < iv->local_end; j++) {
+            v = tz->times[j - 1] + type_offset(tz, j);
+            if (v < iv->local_end)
+                iv->local_end = v;
+        }
+    }
+}
+
+void
+dt_tz_interval(const dt_tz_t *tz, int64_t utc, dt_tz_interval_t *iv) {
+    fill_interval(tz, find_interval(tz, utc), iv);
+}
+
+int64_t
+dt_tz_utc_to_local(const dt_tz_t *tz, int64_t utc, dt_tz_interval_t *cache) {
+    dt_tz_interval_t tmp;
+
+    if (!cache) {
+        cache = &tmp;
+        cache->tz = NULL;
+    }
+    if (cache->tz != tz || utc < cache->start || utc >= cache->end)
+        dt_tz_interval(tz, utc, cache);
+    return utc + cache->offset;
+}
+
+/*
+ * Outside the cached interval, every interval within the largest offset
+ * of local is a candidate: local is in interval k if local minus its
+ * offset falls within it. With two candidates the time is repeated, with
+ * none it was skipped by a transition to a larger offset.
+ */
+int64_t
+dt_tz_local_to_utc(const dt_tz_t *tz, int64_t local, dt_tz_resolve_t resolve,
+                   dt_tz_interval_t *cache) {
+    dt_tz_interval_t tmp;
+    size_t k, lo, hi;
+    int64_t utc, u;
+    int32_t before, after;
+    bool found;
+
+    if (!cache) {
+        cache = &tmp;
+        cache->tz = NULL;
+    }
+    if (cache->tz == tz && local >= cache->local_start && local < cache->local_end)
+        return local - cache->offset;
+
+    lo = find_interval(tz, local > INT64_MIN + tz->max_offset ? local - tz->max_offset : INT64_MIN);
+    hi = find_interval(tz, local < INT64_MAX - tz->max_offset ? local + tz->max_offset : INT64_MAX);
+    utc = local - type_offset(tz, lo);
+    found = false;
+    for (k = lo; k <= hi; k++) {
+        u = local - type_offset(tz, k);
+        if ((k == 0 || u >= tz->times[k - 1]) && (k == tz->n || u < tz->times[k])) {
+            utc = u;
+            found = true;
+            if (resolve == DT_TZ_EARLIER)
+                break;
+        }
+    }
+    for (k = lo; !found && k < hi; k++) {
+        before = type_offset(tz, k);
+        after  = type_offset(tz, k + 1);
+        if (local >= tz->times[k] + before && local < tz->times[k] + after) {
+            utc = resolve == DT_TZ_EARLIER ? local - after : local - before;
+            found = true;
+        }
+    }
+    dt_tz_interval(tz, utc, cache);
+    return utc;
+}
+
+/*
+ * The instants are converted in runs that fall within one interval, with
+ * its offset. The next run starts from the interval of the last one, so
+ * sorted instants walk the transitions once, and others cost a search
+ * that grows with the distance between their intervals. Within a run the
+ * local day is only decoded again when a local time leaves it.
+ */
+void
+dt_tz_utc_to_local_n(const dt_tz_t *tz, const int64_t *src, size_t n, dt_t *dt, int *sod) {
+    dt_timestamp_t ts;
+    int64_t start, end, local, day;
+    int32_t offset;
+    size_t i, k;
+    dt_t cur;
+    int s;
+
+    if (!n)
+        return;
+    ts.nsec = 0;
+    day = 0;
+    cur = DT_TIMESTAMP_EPOCH;
+    i = 0;
+    k = find_interval(tz, src[0]);
+    for (;;) {
+        start  = k ? tz->times[k - 1] : INT64_MIN;
+        end    = k < tz->n ? tz->times[k] : INT64_MAX;
+        offset = type_offset(tz, k);
+        for (; i < n && src[i] >= start && src[i] < end; i++) {
+            local = src[i] + offset;
+            if ((uint64_t)(local - day) >= DT_SECS_PER_DAY) {
+                ts.sec = local;
+                dt_timestamp_to_dt(ts, &cur, &s, NULL);
+                day = local - s;
+            }
+            if (dt)  dt[i]  = cur;
+            if (sod) sod[i] = (int)(local - day);
+        }
+        if (i == n)
+            return;
+        k = find_interval_from(tz, src[i], k);
+    }
+}
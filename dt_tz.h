@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) 2012-2015 Christian Hansen <chansen@cpan.org>
+ * <https://github.com/chansen/c-dt>
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met: 
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer. 
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution. 
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef __DT_TZ_H__
+#define __DT_TZ_H__
+#include <stddef.h>
+#include <stdint.h>
+#include "dt_core.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef DT_TZ_DIR
+#define DT_TZ_DIR "/usr/share/zoneinfo"
+#endif
+
+/* The rule in the footer of a TZif file is expanded through this year */
+#ifndef DT_TZ_LAST_YEAR
+#define DT_TZ_LAST_YEAR 2100
+#endif
+
+typedef enum {
+    DT_TZ_EARLIER,          /* the earlier instant of a repeated or skipped local time */
+    DT_TZ_LATER             /* the later instant */
+} dt_tz_resolve_t;
+
+typedef struct dt_tz dt_tz_t;
+
+/*
+ * An interval of constant offset, from start up to but excluding end, in
+ * seconds since the Unix epoch. The local times from local_start up to
+ * local_end occur within this interval and no other.
+ */
+typedef struct {
+    const dt_tz_t *tz;
+    int64_t        start;
+    int64_t        end;
+    int64_t        local_start;
+    int64_t        local_end;
+    int32_t        offset;      /* seconds east of UTC */
+    bool           dst;
+    const char *   abbr;
+} dt_tz_interval_t;
+
+dt_tz_t *       dt_tz_load              (const char *name);
+dt_tz_t *       dt_tz_parse             (const unsigned char *src, size_t len);
+void            dt_tz_free              (dt_tz_t *tz);
+
+void            dt_tz_interval          (const dt_tz_t *tz, int64_t utc, dt_tz_interval_t *iv);
+int64_t         dt_tz_utc_to_local      (const dt_tz_t *tz, int64_t utc, dt_tz_interval_t *cache);
+int64_t         dt_tz_local_to_utc      (const dt_tz_t *tz, int64_t local, dt_tz_resolve_t resolve,
+                                         dt_tz_interval_t *cache);
+
+void            dt_tz_utc_to_local_n    (const dt_tz_t *tz, const int64_t *src, size_t n,
+                                         dt_t *dt, int *sod);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -24,6 +24,7 @@
  * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  */
 #include <stddef.h>
+#include <string.h>
 #include "dt_core.h"
 #include "dt_weekday.h"
 
@@ -248,3 +249,102 @@ dt_delta_weekdays(dt_t dt1, dt_t dt2, bool inclusive) {
         return 5 * ((dt2 - dt1) / 7) - T[7 * d2 + d1 - 8 + (49 * !!inclusive)];
 }
 
+
+/*
+ * Builds the tables of wk for the given weekend mask, one bit per weekend
+ * day. Returns false if the mask has bits outside DT_WEEKEND_ALL or marks
+ * every day as a weekend day.
+ */
+bool
+dt_weekend_init(dt_weekend_t *wk, unsigned int mask) {
+    bool weekday[15];
+    int a, b, j, k, n;
+
+    if (mask >= DT_WEEKEND_ALL)
+        return false;
+
+    /* weekday[1] through weekday[14] covers two weeks starting on a Monday */
+    for (k = 1; k <= 14; k++)
+        weekday[k] = !(mask & DT_WEEKEND((k - 1) % 7 + 1));
+
+    memset(wk, 0, sizeof(*wk));
+    wk->mask = mask;
+    for (k = 1; k <= 7; k++)
+        wk->days += weekday[k];
+
+    for (a = 1; a <= 7; a++) {
+        for (k = 0; !weekday[a + k]; k++)
+            ;
+        wk->next[1][a] = (signed char)k;
+        for (k = 1; !weekday[a + k]; k++)
+            ;
+        wk->next[0][a] = (signed char)k;
+        for (k = 0; !weekday[a + 7 - k]; k++)
+            ;
+        wk->prev[1][a] = (signed char)k;
+        for (k = 1; !weekday[a + 7 - k]; k++)
+            ;
+        wk->prev[0][a] = (signed char)k;
+
+        for (j = 0, k = 1; k <= 7; k++) {
+            if (weekday[a + k])
+                wk->fwd[a][++j] = (signed char)k;
+        }
+        for (j = 0, k = 1; k <= 7; k++) {
+            if (weekday[a + 7 - k])
+                wk->bwd[a][++j] = (signed char)k;
+        }
+
+        for (b = 1; b <= 7; b++) {
+            n = 0;
+            for (k = a; k <= a + (b - a + 7) % 7; k++)
+                n += weekday[k];
+            wk->count[1][a][b] = (signed char)n;
+            wk->count[0][a][b] = (signed char)(n - (weekday[a] || weekday[b]));
+        }
+    }
+    return true;
+}
+
+bool
+dt_weekend_is_weekday(const dt_weekend_t *wk, dt_t dt) {
+    return !(wk->mask & DT_WEEKEND(dt_dow(dt)));
+}
+
+dt_t
+dt_weekend_next_weekday(const dt_weekend_t *wk, dt_t dt, bool current) {
+    return dt + wk->next[!!current][dt_dow(dt)];
+}
+
+dt_t
+dt_weekend_prev_weekday(const dt_weekend_t *wk, dt_t dt, bool current) {
+    return dt - wk->prev[!!current][dt_dow(dt)];
+}
+
+dt_t
+dt_weekend_add_weekdays(const dt_weekend_t *wk, dt_t dt, int delta) {
+    int w, j;
+
+    if (delta > 0) {
+        w = (delta - 1) / wk->days;
+        j = delta - wk->days * w;
+        return dt + 7 * w + wk->fwd[dt_dow(dt)][j];
+    }
+    else if (delta < 0) {
+        w = (-1 - delta) / wk->days;
+        j = -delta - wk->days * w;
+        return dt - 7 * w - wk->bwd[dt_dow(dt)][j];
+    }
+    return dt;
+}
+
+int
+dt_weekend_delta_weekdays(const dt_weekend_t *wk, dt_t dt1, dt_t dt2, bool inclusive) {
+    const int d1 = dt_dow(dt1);
+    const int d2 = dt_dow(dt2);
+
+    if (dt1 <= dt2)
+        return wk->days * ((dt2 - dt1) / 7) + wk->count[!!inclusive][d1][d2];
+    else
+        return wk->days * ((dt2 - dt1) / 7) - wk->count[!!inclusive][d2][d1];
+}
@@ -32,6 +32,28 @@
 extern "C" {
 #endif
 
+/* Weekend masks, one bit per day of the week */
+#define DT_WEEKEND(dow)     (1U << ((dow) - 1))
+#define DT_WEEKEND_DEFAULT  (DT_WEEKEND(DT_SATURDAY) | DT_WEEKEND(DT_SUNDAY))
+#define DT_WEEKEND_ALL      0x7FU
+
+/*
+ * Lookup tables for an arbitrary weekend mask, built by dt_weekend_init().
+ * They play the part of the constant tables behind dt_next_weekday(),
+ * dt_add_weekdays() and friends, so the dt_weekend_* variants take the
+ * same constant time for any mask. Rows are indexed by day of the week
+ * (DT_MONDAY through DT_SUNDAY), row 0 is unused.
+ */
+typedef struct {
+    unsigned int mask;
+    int          days;              /* weekdays per week */
+    signed char  next[2][8];        /* [current][dow] days to the next weekday */
+    signed char  prev[2][8];        /* [current][dow] days to the previous weekday */
+    signed char  fwd[8][8];         /* [dow][j] days to the j-th weekday after */
+    signed char  bwd[8][8];         /* [dow][j] days to the j-th weekday before */
+    signed char  count[2][8][8];    /* [inclusive][dow1][dow2] weekdays from dow1 to dow2 */
+} dt_weekend_t;
+
 dt_t    dt_from_nth_weekday_in_year     (int y, int nth);
 dt_t    dt_from_nth_weekday_in_quarter  (int y, int q, int nth);
 dt_t    dt_from_nth_weekday_in_month    (int y, int m, int nth);
@@ -53,6 +75,13 @@ dt_t    dt_add_weekdays                 (dt_t dt, int delta);
 
 int     dt_delta_weekdays               (dt_t start, dt_t end, bool inclusive);
 
+bool    dt_weekend_init                 (dt_weekend_t *wk, unsigned int mask);
+bool    dt_weekend_is_weekday           (const dt_weekend_t *wk, dt_t dt);
+dt_t    dt_weekend_next_weekday         (const dt_weekend_t *wk, dt_t dt, bool current);
+dt_t    dt_weekend_prev_weekday         (const dt_weekend_t *wk, dt_t dt, bool current);
+dt_t    dt_weekend_add_weekdays         (const dt_weekend_t *wk, dt_t dt, int delta);
+int     dt_weekend_delta_weekdays       (const dt_weekend_t *wk, dt_t start, dt_t end, bool inclusive);
+
 #ifdef __cplusplus
 }
 #endif
@@ -130,20 +130,17 @@ dt_prev_workday(dt_t dt, bool current, const dt_t *holidays, size_t n) {
 #define MIN(x, y) (((x) < (y)) ? (x) : (y))
 #define MAX(x, y) (((x) > (y)) ? (x) : (y))
 
-dt_t
-dt_add_workdays(dt_t dt, int delta, const dt_t *holidays, size_t n) {
-    const dt_t *end, *lo, *up;
-
-    if (!delta)
-        return dt;
-
-    if (!n)
-        return dt_add_weekdays(dt, delta);
-
-    end = holidays + n;
+/*
+ * Adds delta workdays to dt, given pos, the first holiday after dt when
+ * delta is positive or the first holiday not before dt when it is
+ * negative.
+ */
+static dt_t
+add_workdays(dt_t dt, int delta, const dt_t *pos, const dt_t *holidays, const dt_t *end) {
+    const dt_t *lo, *up;
 
     if (delta > 0) {
-        lo = dt_lower_bound(dt + 1, holidays, end);
+        lo = pos;
         do {
             dt = dt_add_weekdays(dt, delta);
             up = dt_upper_bound(dt, lo, MIN(lo + delta, end));
@@ -153,7 +150,7 @@ dt_add_workdays(dt_t dt, int delta, const dt_t *holidays, size_t n) {
         } while (delta);
     }
     else {
-        up = dt_upper_bound(dt - 1, holidays, end);
+        up = pos;
         do {
             dt = dt_add_weekdays(dt, delta);
             lo = dt_lower_bound(dt, MAX(up + delta, holidays), up);
@@ -165,13 +162,34 @@ dt_add_workdays(dt_t dt, int delta, const dt_t *holidays, size_t n) {
     return dt;
 }
 
+dt_t
+dt_add_workdays(dt_t dt, int delta, const dt_t *holidays, size_t n) {
+    const dt_t *end, *pos;
+
+    if (!delta)
+        return dt;
+
+    if (!n)
+        return dt_add_weekdays(dt, delta);
+
+    end = holidays + n;
+    if (delta > 0)
+        pos = dt_lower_bound(dt + 1, holidays, end);
+    else
+        pos = dt_upper_bound(dt - 1, holidays, end);
+    return add_workdays(dt, delta, pos, holidays, end);
+}
+
 int
 dt_delta_workdays(dt_t dt1, dt_t dt2, bool inclusive, const dt_t *holidays, size_t n) {
     const dt_t *end, *lo, *up;
     int delta;
 
-    delta = dt_delta_weekdays(dt1, dt2, inclusive);
-    if (!delta || !n)
+    if (!n)
+        return dt_delta_weekdays(dt1, dt2, inclusive);
+
+    delta = dt_delta_weekdays(dt1, dt2, true);
+    if (!delta)
         return delta;
 
     end = holidays + n;
@@ -186,6 +204,15 @@ dt_delta_workdays(dt_t dt1, dt_t dt2, bool inclusive, const dt_t *holidays, size
         lo = dt_lower_bound(dt2, MAX(up + delta, holidays), up);
         delta -= lo - up;
     }
+
+    /*
+     * As with dt_delta_weekdays(), the exclusive count leaves out the
+     * earlier date if it is a workday, and otherwise the later date.
+     */
+    if (!inclusive && delta) {
+        if (dt_is_workday(dt1, holidays, n) || dt_is_workday(dt2, holidays, n))
+            delta += (delta > 0) ? -1 : 1;
+    }
     return delta;
 }
 
@@ -225,3 +252,114 @@ dt_roll_workday(dt_t dt, dt_bdc_t convention, const dt_t *holidays, size_t n) {
 }
 
 
+
+/*
+ * A cursor over the holiday list for the batch functions. Each search
+ * starts from the previous position with dt_lower_bound_hint(), so a
+ * sorted batch costs a single pass over the holidays, and any other order
+ * only costs the searches.
+ */
+typedef struct {
+    const dt_t *first;
+    const dt_t *last;
+    const dt_t *pos;
+} cursor_t;
+
+/* Moves the cursor to the first holiday not before dt */
+static const dt_t *
+cursor_seek(cursor_t *c, dt_t dt) {
+    return c->pos = dt_lower_bound_hint(dt, c->first, c->last, c->pos);
+}
+
+static dt_t
+cursor_next_workday(cursor_t *c, dt_t dt, bool current) {
+    const dt_t *p;
+
+    dt = dt_next_weekday(dt, current);
+    p = cursor_seek(c, dt);
+    while (p < c->last && *p == dt) {
+        dt = dt_next_weekday(dt, false);
+        while (p < c->last && *p < dt)
+            p++;
+    }
+    return dt;
+}
+
+static dt_t
+cursor_prev_workday(cursor_t *c, dt_t dt, bool current) {
+    const dt_t *p;
+
+    dt = dt_prev_weekday(dt, current);
+    p = cursor_seek(c, dt);
+    while (p < c->last && *p == dt) {
+        dt = dt_prev_weekday(dt, false);
+        while (p > c->first && p[-1] >= dt)
+            p--;
+    }
+    return dt;
+}
+
+void
+dt_roll_workday_n(const dt_t *src, size_t n, dt_bdc_t convention,
+                  const dt_t *holidays, size_t nholidays, dt_t *dst) {
+    cursor_t c;
+    dt_t dt, start;
+    size_t i;
+    int y, m;
+
+    c.first = c.pos = holidays;
+    c.last  = holidays + nholidays;
+
+    for (i = 0; i < n; i++) {
+        start = dt = src[i];
+        switch (convention) {
+            case DT_UNADJUSTED:
+                break;
+            case DT_FOLLOWING:
+                dt = cursor_next_workday(&c, dt, true);
+                break;
+            case DT_MODIFIED_FOLLOWING:
+                dt = cursor_next_workday(&c, dt, true);
+                if (dt != start) {
+                    dt_to_ymd(start, &y, &m, NULL);
+                    if (dt > dt_from_ymd(y, m + 1, 0))
+                        dt = cursor_prev_workday(&c, start, false);
+                }
+                break;
+            case DT_PRECEDING:
+                dt = cursor_prev_workday(&c, dt, true);
+                break;
+            case DT_MODIFIED_PRECEDING:
+                dt = cursor_prev_workday(&c, dt, true);
+                if (dt != start) {
+                    dt_to_ymd(start, &y, &m, NULL);
+                    if (dt < dt_from_ymd(y, m, 1))
+                        dt = cursor_next_workday(&c, start, false);
+                }
+                break;
+        }
+        dst[i] = dt;
+    }
+}
+
+void
+dt_add_workdays_n(const dt_t *src, size_t n, int delta,
+                  const dt_t *holidays, size_t nholidays, dt_t *dst) {
+    cursor_t c;
+    const dt_t *pos;
+    size_t i;
+
+    if (!delta || !nholidays) {
+        for (i = 0; i < n; i++)
+            dst[i] = dt_add_weekdays(src[i], delta);
+        return;
+    }
+
+    c.first = c.pos = holidays;
+    c.last  = holidays + nholidays;
+
+    for (i = 0; i < n; i++) {
+        pos = cursor_seek(&c, src[i] + (delta > 0));
+        dst[i] = add_workdays(src[i], delta, pos, holidays, c.last);
+    }
+}
@@ -60,6 +60,11 @@ int     dt_delta_workdays               (dt_t start, dt_t end, bool inclusive, c
 
 dt_t    dt_roll_workday                 (dt_t dt, dt_bdc_t convention, const dt_t *holidays, size_t n);
 
+void    dt_roll_workday_n               (const dt_t *src, size_t n, dt_bdc_t convention,
+                                         const dt_t *holidays, size_t nholidays, dt_t *dst);
+void    dt_add_workdays_n               (const dt_t *src, size_t n, int delta,
+                                         const dt_t *holidays, size_t nholidays, dt_t *dst);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,165 @@
+/*
+ * Copyright (c) 2012-2015 Christian Hansen <chansen@cpan.org>
+ * <https://github.com/chansen/c-dt>
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met: 
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer. 
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution. 
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef __DT_WRITER_H__
+#define __DT_WRITER_H__
+#include <stdbool.h>
+#include <string.h>
+
+/*
+ * Digit writers shared by the ISO 8601 and the pattern formatters. This
+ * header is private to the library. The tables are defined by the
+ * translation unit that defines DT_WRITER_DEFINE before including it.
+ */
+
+extern const char dt_writer_digits[200];
+extern const int  dt_writer_pow10[10];
+
+#ifdef DT_WRITER_DEFINE
+const char dt_writer_digits[200] = {
+    '0','0','0','1','0','2','0','3','0','4','0','5','0','6','0','7','0','8','0','9',
+    '1','0','1','1','1','2','1','3','1','4','1','5','1','6','1','7','1','8','1','9',
+    '2','0','2','1','2','2','2','3','2','4','2','5','2','6','2','7','2','8','2','9',
+    '3','0','3','1','3','2','3','3','3','4','3','5','3','6','3','7','3','8','3','9',
+    '4','0','4','1','4','2','4','3','4','4','4','5','4','6','4','7','4','8','4','9',
+    '5','0','5','1','5','2','5','3','5','4','5','5','5','6','5','7','5','8','5','9',
+    '6','0','6','1','6','2','6','3','6','4','6','5','6','6','6','7','6','8','6','9',
+    '7','0','7','1','7','2','7','3','7','4','7','5','7','6','7','7','7','8','7','9',
+    '8','0','8','1','8','2','8','3','8','4','8','5','8','6','8','7','8','8','8','9',
+    '9','0','9','1','9','2','9','3','9','4','9','5','9','6','9','7','9','8','9','9',
+};
+
+const int dt_writer_pow10[10] = {
+    1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000,
+};
+#endif
+
+/*
+ * The writers index the digit table with hours and minutes, the callers
+ * reject a time outside of 00:00:00 to 24:00:00 and an offset outside of
+ * -23:59 to +23:59 first.
+ */
+static inline bool
+dt_writer_valid_time(int sod, int nsec) {
+    return sod >= 0 && sod <= 86400 && nsec >= 0 && nsec <= 999999999;
+}
+
+static inline bool
+dt_writer_valid_offset(int offset) {
+    return offset >= -1439 && offset <= 1439;
+}
+
+/* Writes v (0-99) as two digits */
+static inline char *
+dt_writer_put2(char *p, unsigned int v) {
+    memcpy(p, dt_writer_digits + 2 * v, 2);
+    return p + 2;
+}
+
+/*
+ * Writes the year with at least four digits. Negative years are preceded
+ * by a '-' and, if plus is true, years above 9999 by a '+', which is the
+ * expanded representation of ISO 8601. At most 11 characters.
+ */
+static inline char *
+dt_writer_put_year(char *p, int y, bool plus) {
+    unsigned int v;
+    char tmp[10], *t;
+
+    if ((unsigned int)y <= 9999) {
+        p = dt_writer_put2(p, (unsigned int)y / 100);
+        return dt_writer_put2(p, (unsigned int)y % 100);
+    }
+
+    if (y < 0) {
+        *p++ = '-';
+        v = 0U - (unsigned int)y;
+    }
+    else {
+        if (plus)
+            *p++ = '+';
+        v = (unsigned int)y;
+    }
+
+    t = tmp + sizeof(tmp);
+    while (v >= 100) {
+        t -= 2;
+        memcpy(t, dt_writer_digits + 2 * (v % 100), 2);
+        v /= 100;
+    }
+    if (v >= 10) {
+        t -= 2;
+        memcpy(t, dt_writer_digits + 2 * v, 2);
+    }
+    else
+        *--t = (char)('0' + v);
+    while (t > tmp + sizeof(tmp) - 4)
+        *--t = '0';
+
+    memcpy(p, t, tmp + sizeof(tmp) - t);
+    return p + (tmp + sizeof(tmp) - t);
+}
+
+/* Writes the leading digits (1-9) of the nanoseconds, truncated */
+static inline char *
+dt_writer_put_fraction(char *p, int nsec, int digits) {
+    unsigned int f;
+    char *e;
+
+    f = (unsigned int)(nsec / dt_writer_pow10[9 - digits]);
+    e = p + digits;
+    p = e;
+    if (digits & 1) {
+        *--p = (char)('0' + f % 10);
+        f /= 10;
+    }
+    while (p > e - digits) {
+        p -= 2;
+        memcpy(p, dt_writer_digits + 2 * (f % 100), 2);
+        f /= 100;
+    }
+    return e;
+}
+
+/* Writes the offset in minutes as +hhmm, or +hh:mm if extended */
+static inline char *
+dt_writer_put_offset(char *p, int offset, bool extended) {
+    unsigned int o;
+
+    if (offset < 0) {
+        *p++ = '-';
+        o = 0U - (unsigned int)offset;
+    }
+    else {
+        *p++ = '+';
+        o = (unsigned int)offset;
+    }
+    p = dt_writer_put2(p, o / 60);
+    if (extended)
+        *p++ = ':';
+    return dt_writer_put2(p, o % 60);
+}
+
+#endif
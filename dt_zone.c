@@ -68,31 +68,32 @@ static const dt_zone_t kZoneEntry[] = {
     #undef DT_ZONE_ENTRY
 };
 
+static const unsigned int kZoneEnc[] = {
+    0, /* empty slot */
+    #define DT_ZONE_ENTRY(enc, offset, name, flags) \
+        enc,
+    #include "dt_zone_entries.h"
+    #undef DT_ZONE_ENTRY
+};
+
+#include "dt_zone_hash.h"
+
+/*
+ * The slots of kZoneSlot are indexed by a multiplicative hash of the
+ * encoding, which tools/zone.pl has chosen so that no two entries share
+ * a slot. A slot holds the index of its entry plus one, so an empty slot
+ * refers to the zero encoding, which no name has.
+ */
 static bool
 dt_zone_lookup_enc(unsigned int enc, const dt_zone_t **zone) {
-    static const unsigned int T[] = {
-        #define DT_ZONE_ENTRY(enc, offset, name, flags) \
-            enc,
-        #include "dt_zone_entries.h"
-        #undef DT_ZONE_ENTRY
-    };
-    size_t lo, hi, mid;
-
-    assert(ARRAY_SIZE(T) > 0);
-
-    lo = 0;
-    hi = ARRAY_SIZE(T) - 1;
-    while (lo < hi) {
-        mid = (lo + hi) / 2;
-        if (T[mid] < enc)
-            lo = mid + 1;
-        else
-            hi = mid;
-    }
+    unsigned int i;
+
+    assert(ARRAY_SIZE(kZoneEnc) == ARRAY_SIZE(kZoneEntry) + 1);
 
-    if (lo == hi && T[lo] == enc) {
+    i = kZoneSlot[(enc * DT_ZONE_HASH_MULTIPLIER & 0xFFFFFFFFU) >> (32 - DT_ZONE_HASH_BITS)];
+    if (kZoneEnc[i] == enc) {
         if (zone)
-            *zone = &kZoneEntry[lo];
+            *zone = &kZoneEntry[i - 1];
         return true;
     }
     return false;
@@ -0,0 +1,92 @@
+#include <stdlib.h>
+#include "dt.h"
+#include "tap.h"
+#include "util.h"
+
+#define N 2000
+
+static dt_t src[N], dst[N];
+static dt_t holidays[N];
+
+static int
+compare_dt(const void *a, const void *b) {
+    const dt_t x = *(const dt_t *)a;
+    const dt_t y = *(const dt_t *)b;
+    return (x > y) - (x < y);
+}
+
+/* Sorted, unique weekdays, about one in every dense days */
+static size_t
+fill_holidays(dt_t first, dt_t last, unsigned int dense, unsigned int *state) {
+    size_t n;
+    dt_t dt;
+
+    n = 0;
+    for (dt = first; dt <= last && n < N; dt++) {
+        if (dt_is_weekday(dt) && (next_rand(state) >> 8) % dense == 0)
+            holidays[n++] = dt;
+    }
+    return n;
+}
+
+static const int deltas[] = {
+    -300, -22, -5, -1, 0, 1, 3, 10, 260,
+};
+
+static bool
+compare(size_t n, const dt_t *holidays, size_t nholidays, const char *order) {
+    size_t d, i;
+    dt_t exp;
+
+    for (d = 0; d < sizeof(deltas) / sizeof(*deltas); d++) {
+        dt_add_workdays_n(src, n, deltas[d], holidays, nholidays, dst);
+        for (i = 0; i < n; i++) {
+            exp = dt_add_workdays(src[i], deltas[d], holidays, nholidays);
+            if (dst[i] != exp) {
+                diag("%s, delta %d, %d holidays: dt %d got %d exp %d",
+                     order, deltas[d], (int)nholidays, src[i], dst[i], exp);
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+int
+main() {
+    static const unsigned int densities[] = { 1000000, 40, 3, 1 };
+    unsigned int state;
+    size_t d, i, n, nholidays;
+    dt_t first, t;
+
+    state = 1;
+    first = dt_from_ymd(2010, 1, 1);
+    for (d = 0; d < sizeof(densities) / sizeof(*densities); d++) {
+        nholidays = fill_holidays(first - 400, first + 2400, densities[d], &state);
+
+        /* A schedule, every few days in ascending order */
+        for (i = 0, n = 0; i < N; i++, n++)
+            src[i] = first + (dt_t)(i * 3 / 2);
+        ok(compare(n, holidays, nholidays, "ascending"),
+           "dt_add_workdays_n() ascending, %d holidays", (int)nholidays);
+
+        for (i = 0; i < n / 2; i++) {
+            t = src[i];
+            src[i] = src[n - 1 - i];
+            src[n - 1 - i] = t;
+        }
+        ok(compare(n, holidays, nholidays, "descending"),
+           "dt_add_workdays_n() descending, %d holidays", (int)nholidays);
+
+        for (i = 0; i < n; i++)
+            src[i] = first - 300 + (dt_t)((next_rand(&state) >> 8) % 2400);
+        ok(compare(n, holidays, nholidays, "random"),
+           "dt_add_workdays_n() random, %d holidays", (int)nholidays);
+
+        qsort(src, n, sizeof(dt_t), compare_dt);
+        ok(compare(n, holidays, nholidays, "sorted"),
+           "dt_add_workdays_n() sorted with repeats, %d holidays", (int)nholidays);
+    }
+    ok(compare(0, holidays, 0, "empty"), "dt_add_workdays_n() no dates");
+    done_testing();
+}
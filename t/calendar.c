@@ -0,0 +1,335 @@
+#include <stdlib.h>
+#include "dt.h"
+#include "tap.h"
+#include "util.h"
+
+static int
+compare_dt(const void *a, const void *b) {
+    const dt_t x = *(const dt_t *)a;
+    const dt_t y = *(const dt_t *)b;
+    return (x > y) - (x < y);
+}
+
+/* Reference implementations, one day at a time */
+
+static bool
+ref_is_workday(dt_t dt, unsigned int weekend, const dt_t *holidays, size_t n) {
+    if (weekend & DT_WEEKEND(dt_dow(dt)))
+        return false;
+    return !bsearch(&dt, holidays, n, sizeof(dt_t), compare_dt);
+}
+
+static dt_t
+ref_next_workday(dt_t dt, bool current, unsigned int weekend, const dt_t *holidays, size_t n) {
+    if (!current)
+        dt++;
+    while (!ref_is_workday(dt, weekend, holidays, n))
+        dt++;
+    return dt;
+}
+
+static dt_t
+ref_prev_workday(dt_t dt, bool current, unsigned int weekend, const dt_t *holidays, size_t n) {
+    if (!current)
+        dt--;
+    while (!ref_is_workday(dt, weekend, holidays, n))
+        dt--;
+    return dt;
+}
+
+static dt_t
+ref_add_workdays(dt_t dt, int delta, unsigned int weekend, const dt_t *holidays, size_t n) {
+    for (; delta > 0; delta--)
+        dt = ref_next_workday(dt, false, weekend, holidays, n);
+    for (; delta < 0; delta++)
+        dt = ref_prev_workday(dt, false, weekend, holidays, n);
+    return dt;
+}
+
+static int
+ref_delta_workdays(dt_t start, dt_t end, bool inclusive, unsigned int weekend,
+                   const dt_t *holidays, size_t n) {
+    int delta;
+    dt_t dt;
+
+    if (start > end)
+        return -ref_delta_workdays(end, start, inclusive, weekend, holidays, n);
+    delta = 0;
+    for (dt = start; dt <= end; dt++)
+        delta += ref_is_workday(dt, weekend, holidays, n);
+    if (!inclusive && (ref_is_workday(start, weekend, holidays, n) ||
+                       ref_is_workday(end, weekend, holidays, n)))
+        delta--;
+    return delta;
+}
+
+static const int deltas[] = {
+    -400, -70, -5, -1, 1, 3, 40, 400,
+};
+
+static const int offsets[] = {
+    -400, -37, -1, 0, 1, 6, 45, 400,
+};
+
+static const dt_bdc_t conventions[] = {
+    DT_UNADJUSTED,
+    DT_FOLLOWING,
+    DT_MODIFIED_FOLLOWING,
+    DT_PRECEDING,
+    DT_MODIFIED_PRECEDING,
+};
+
+/*
+ * Compares a calendar over [first, last] against the array based
+ * functions (default weekend) or the reference implementations for
+ * every day of [from, to].
+ */
+static void
+check_calendar(const char *name, dt_t first, dt_t last, unsigned int weekend,
+               const dt_t *holidays, size_t n, dt_t from, dt_t to) {
+    dt_calendar_t *cal;
+    dt_t *sorted;
+    dt_t dt, got, exp;
+    size_t i, j;
+    bool good;
+
+    cal = dt_calendar_new(first, last, weekend, holidays, n);
+    ok(cal != NULL, "%s: dt_calendar_new()", name);
+    if (!cal)
+        return;
+
+    sorted = (dt_t *)malloc((n + 1) * sizeof(dt_t));
+    for (i = 0; i < n; i++)
+        sorted[i] = holidays[i];
+    qsort(sorted, n, sizeof(dt_t), compare_dt);
+    for (i = 0, j = 0; i < n; i++) {
+        if (!j || sorted[i] != sorted[j - 1])
+            sorted[j++] = sorted[i];
+    }
+    n = j;
+
+    good = true;
+    for (dt = from; good && dt <= to; dt++) {
+        if (weekend == DT_WEEKEND_DEFAULT) {
+            good = dt_calendar_is_workday(cal, dt) == dt_is_workday(dt, sorted, n);
+            good = good && dt_calendar_next_workday(cal, dt, false) == dt_next_workday(dt, false, sorted, n);
+            good = good && dt_calendar_next_workday(cal, dt, true) == dt_next_workday(dt, true, sorted, n);
+            good = good && dt_calendar_prev_workday(cal, dt, false) == dt_prev_workday(dt, false, sorted, n);
+            good = good && dt_calendar_prev_workday(cal, dt, true) == dt_prev_workday(dt, true, sorted, n);
+            for (i = 0; good && i < sizeof(conventions) / sizeof(*conventions); i++) {
+                got = dt_calendar_roll_workday(cal, dt, conventions[i]);
+                exp = dt_roll_workday(dt, conventions[i], sorted, n);
+                good = (got == exp);
+            }
+        }
+        else {
+            good = dt_calendar_is_workday(cal, dt) == ref_is_workday(dt, weekend, sorted, n);
+            good = good && dt_calendar_next_workday(cal, dt, false) == ref_next_workday(dt, false, weekend, sorted, n);
+            good = good && dt_calendar_next_workday(cal, dt, true) == ref_next_workday(dt, true, weekend, sorted, n);
+            good = good && dt_calendar_prev_workday(cal, dt, false) == ref_prev_workday(dt, false, weekend, sorted, n);
+            good = good && dt_calendar_prev_workday(cal, dt, true) == ref_prev_workday(dt, true, weekend, sorted, n);
+        }
+    }
+    ok(good, "%s: agrees with the reference for every day", name);
+    if (!good) {
+        int y, m, d;
+        dt_to_ymd(dt - 1, &y, &m, &d);
+        diag("first mismatch at %04d-%02d-%02d", y, m, d);
+    }
+
+    /* Only the short lists hold nothing but weekday holidays, which the
+       array based functions expect */
+    good = true;
+    for (dt = from; good && dt <= to; dt++) {
+        for (i = 0; good && i < sizeof(deltas) / sizeof(*deltas); i++) {
+            got = dt_calendar_add_workdays(cal, dt, deltas[i]);
+            exp = ref_add_workdays(dt, deltas[i], weekend, sorted, n);
+            good = (got == exp);
+            if (good && weekend == DT_WEEKEND_DEFAULT && n < 20) {
+                exp = dt_add_workdays(dt, deltas[i], sorted, n);
+                good = (got == exp);
+            }
+            if (!good)
+                diag("dt_calendar_add_workdays(%d, %d): got %d, exp %d", dt, deltas[i], got, exp);
+        }
+        for (i = 0; good && i < sizeof(offsets) / sizeof(*offsets); i++) {
+            int gd, ed;
+            gd = dt_calendar_delta_workdays(cal, dt, dt + offsets[i], false);
+            ed = ref_delta_workdays(dt, dt + offsets[i], false, weekend, sorted, n);
+            good = (gd == ed);
+            if (good) {
+                gd = dt_calendar_delta_workdays(cal, dt, dt + offsets[i], true);
+                ed = ref_delta_workdays(dt, dt + offsets[i], true, weekend, sorted, n);
+                good = (gd == ed);
+            }
+            if (good && weekend == DT_WEEKEND_DEFAULT && n < 20) {
+                gd = dt_calendar_delta_workdays(cal, dt, dt + offsets[i], false);
+                ed = dt_delta_workdays(dt, dt + offsets[i], false, sorted, n);
+                good = (gd == ed);
+            }
+            if (!good)
+                diag("dt_calendar_delta_workdays(%d, %d): got %d, exp %d", dt, dt + offsets[i], gd, ed);
+        }
+    }
+    ok(good, "%s: add and delta agree with the reference", name);
+
+    free(sorted);
+    dt_calendar_free(cal);
+}
+
+/* Brute force checks of a joint calendar against its components */
+
+static bool
+joint_is_workday(const dt_calendar_t *a, const dt_calendar_t *b, dt_join_t how, dt_t dt) {
+    if (how == DT_JOIN_ALL)
+        return dt_calendar_is_workday(a, dt) && dt_calendar_is_workday(b, dt);
+    return dt_calendar_is_workday(a, dt) || dt_calendar_is_workday(b, dt);
+}
+
+static void
+check_join(const char *name, const dt_calendar_t *a, const dt_calendar_t *b,
+           dt_join_t how, dt_t from, dt_t to) {
+    dt_calendar_cache_t *cache;
+    const dt_calendar_t *cal;
+    dt_t dt, exp;
+    size_t i;
+    int k, count;
+    bool good;
+
+    cache = dt_calendar_cache_new();
+    cal = dt_calendar_cache_join(cache, a, b, how);
+    ok(cal != NULL, "%s: dt_calendar_cache_join()", name);
+    if (!cal) {
+        dt_calendar_cache_free(cache);
+        return;
+    }
+    ok(dt_calendar_cache_join(cache, b, a, how) == cal, "%s: the join is cached", name);
+
+    good = true;
+    for (dt = from; good && dt <= to; dt++) {
+        good = dt_calendar_is_workday(cal, dt) == joint_is_workday(a, b, how, dt);
+        for (i = 0; good && i < sizeof(deltas) / sizeof(*deltas); i++) {
+            exp = dt;
+            for (k = deltas[i]; k > 0; k--) {
+                do exp++; while (!joint_is_workday(a, b, how, exp));
+            }
+            for (k = deltas[i]; k < 0; k++) {
+                do exp--; while (!joint_is_workday(a, b, how, exp));
+            }
+            good = dt_calendar_add_workdays(cal, dt, deltas[i]) == exp;
+        }
+        for (i = 0; good && i < sizeof(offsets) / sizeof(*offsets); i++) {
+            if (offsets[i] <= 0)
+                continue;
+            count = 0;
+            for (exp = dt; exp <= dt + offsets[i]; exp++)
+                count += joint_is_workday(a, b, how, exp);
+            good = dt_calendar_delta_workdays(cal, dt, dt + offsets[i], true) == count
+                && dt_calendar_delta_workdays(cal, dt + offsets[i], dt, true) == -count;
+        }
+    }
+    ok(good, "%s: agrees with the components for every day", name);
+    dt_calendar_cache_free(cache);
+}
+
+int
+main() {
+    unsigned int state;
+    dt_t holidays[600];
+    dt_t first, last;
+    size_t i, n;
+
+    /* Swedish public holidays 2013, unsorted and with duplicates */
+    static const struct ymd {
+        int y, m, d;
+    } days[] = {
+        {2013, 12, 25}, {2013,  1,  1}, {2013,  3, 29}, {2013,  4,  1},
+        {2013,  5,  1}, {2013,  5,  9}, {2013,  6,  6}, {2013,  6, 21},
+        {2013, 12, 24}, {2013, 12, 26}, {2013, 12, 31}, {2013,  5,  1},
+        {2014,  1,  1}, {2014,  1,  6}, {2012, 12, 24}, {2012, 12, 25},
+    };
+
+    ok(dt_calendar_new(dt_from_ymd(2013, 1, 2), dt_from_ymd(2013, 1, 1),
+                       DT_WEEKEND_DEFAULT, NULL, 0) == NULL,
+       "dt_calendar_new() rejects an empty span");
+    ok(dt_calendar_new(dt_from_ymd(2013, 1, 1), dt_from_ymd(2013, 12, 31),
+                       DT_WEEKEND_ALL, NULL, 0) == NULL,
+       "dt_calendar_new() rejects a week without workdays");
+    ok(dt_calendar_new(dt_from_ymd(2013, 1, 1), dt_from_ymd(2013, 12, 31),
+                       0x80, NULL, 0) == NULL,
+       "dt_calendar_new() rejects an invalid weekend mask");
+    dt_calendar_free(NULL);
+
+    n = sizeof(days) / sizeof(*days);
+    for (i = 0; i < n; i++)
+        holidays[i] = dt_from_ymd(days[i].y, days[i].m, days[i].d);
+
+    check_calendar("2013 within span", dt_from_ymd(2012, 12, 1), dt_from_ymd(2014, 1, 31),
+                   DT_WEEKEND_DEFAULT, holidays, n,
+                   dt_from_ymd(2012, 12, 20), dt_from_ymd(2014, 1, 10));
+    check_calendar("2013 partial span", dt_from_ymd(2013, 3, 30), dt_from_ymd(2013, 12, 24),
+                   DT_WEEKEND_DEFAULT, holidays, n,
+                   dt_from_ymd(2012, 11, 1), dt_from_ymd(2014, 2, 28));
+    check_calendar("2013 single day span", dt_from_ymd(2013, 12, 24), dt_from_ymd(2013, 12, 24),
+                   DT_WEEKEND_DEFAULT, holidays, n,
+                   dt_from_ymd(2013, 12, 1), dt_from_ymd(2014, 1, 31));
+    check_calendar("no holidays", dt_from_ymd(2013, 1, 1), dt_from_ymd(2013, 1, 1) + 127,
+                   DT_WEEKEND_DEFAULT, NULL, 0,
+                   dt_from_ymd(2012, 12, 1), dt_from_ymd(2013, 6, 30));
+    check_calendar("friday and saturday", dt_from_ymd(2013, 3, 30), dt_from_ymd(2013, 12, 24),
+                   DT_WEEKEND(DT_FRIDAY) | DT_WEEKEND(DT_SATURDAY), holidays, n,
+                   dt_from_ymd(2012, 11, 1), dt_from_ymd(2014, 2, 28));
+    check_calendar("friday only", dt_from_ymd(2013, 1, 1), dt_from_ymd(2013, 12, 31),
+                   DT_WEEKEND(DT_FRIDAY), holidays, n,
+                   dt_from_ymd(2012, 11, 1), dt_from_ymd(2014, 2, 28));
+    check_calendar("no weekend", dt_from_ymd(2013, 1, 1), dt_from_ymd(2013, 12, 31),
+                   0, holidays, n,
+                   dt_from_ymd(2012, 11, 1), dt_from_ymd(2014, 2, 28));
+
+    /* Joint calendars, with different spans and weekends */
+    {
+        static const struct ymd more[] = {
+            {2013,  1,  1}, {2013,  1, 21}, {2013,  2, 18}, {2013,  5, 27},
+            {2013,  7,  4}, {2013,  9,  2}, {2013, 10, 14}, {2013, 11, 11},
+            {2013, 11, 28}, {2013, 12, 25}, {2013,  6,  7}, {2013,  6, 14},
+        };
+        dt_calendar_t *a, *b, *c;
+        dt_t other[12];
+
+        for (i = 0; i < 12; i++)
+            other[i] = dt_from_ymd(more[i].y, more[i].m, more[i].d);
+        n = sizeof(days) / sizeof(*days);
+        a = dt_calendar_new(dt_from_ymd(2013, 1, 1), dt_from_ymd(2013, 12, 31),
+                            DT_WEEKEND_DEFAULT, holidays, n);
+        b = dt_calendar_new(dt_from_ymd(2013, 3, 1), dt_from_ymd(2014, 2, 28),
+                            DT_WEEKEND_DEFAULT, other, 12);
+        c = dt_calendar_new(dt_from_ymd(2012, 6, 1), dt_from_ymd(2013, 6, 30),
+                            DT_WEEKEND(DT_FRIDAY) | DT_WEEKEND(DT_SATURDAY), other, 12);
+
+        check_join("join all", a, b, DT_JOIN_ALL, dt_from_ymd(2012, 11, 1), dt_from_ymd(2014, 4, 30));
+        check_join("join any", a, b, DT_JOIN_ANY, dt_from_ymd(2012, 11, 1), dt_from_ymd(2014, 4, 30));
+        check_join("join all, friday and saturday", a, c, DT_JOIN_ALL,
+                   dt_from_ymd(2012, 5, 1), dt_from_ymd(2014, 2, 28));
+        check_join("join any, friday and saturday", b, c, DT_JOIN_ANY,
+                   dt_from_ymd(2012, 5, 1), dt_from_ymd(2014, 4, 30));
+        ok(dt_calendar_join(a, b, (dt_join_t)7) == NULL, "dt_calendar_join() rejects an unknown join");
+
+        dt_calendar_free(a);
+        dt_calendar_free(b);
+        dt_calendar_free(c);
+    }
+
+    /* Dense random holidays, including long runs of consecutive days */
+    state = 1;
+    first = dt_from_ymd(2000, 1, 1);
+    last  = dt_from_ymd(2001, 12, 31);
+    for (i = 0; i < 600; i++)
+        holidays[i] = first - 30 + (dt_t)((next_rand(&state) >> 8) % 790);
+
+    check_calendar("dense random", first, last, DT_WEEKEND_DEFAULT, holidays, 600,
+                   first - 60, last + 60);
+    check_calendar("dense random, sunday", first, last, DT_WEEKEND(DT_SUNDAY), holidays, 600,
+                   first - 60, last + 60);
+
+    done_testing();
+}
@@ -0,0 +1,77 @@
+#include "dt.h"
+#include "tap.h"
+#include "util.h"
+
+/* Compares the fields of the cursor with a full decode of its date */
+static bool
+check(const dt_cursor_t *c, const char *name) {
+    int y, m, d, doy, wy, w, dow;
+
+    dt_to_ymd(c->dt, &y, &m, &d);
+    dt_to_yd(c->dt, &y, &doy);
+    dt_to_ywd(c->dt, &wy, &w, &dow);
+    if (c->year != y || c->month != m || c->day != d || c->doy != doy
+        || c->dow != dow || c->week_year != wy || c->week != w
+        || c->quarter != dt_quarter(c->dt) || c->leap != dt_leap_year(y)) {
+        diag("%s: %04d-%02d-%02d doy %d, %04d-W%02d-%d q%d%s, exp %04d-%02d-%02d doy %d, %04d-W%02d-%d",
+             name, c->year, c->month, c->day, c->doy, c->week_year, c->week, c->dow,
+             c->quarter, c->leap ? " leap" : "", y, m, d, doy, wy, w, dow);
+        return false;
+    }
+    return true;
+}
+
+int
+main() {
+    unsigned int state;
+    dt_cursor_t c;
+    dt_t first, last, dt;
+    bool good;
+    int i, delta;
+
+    first = dt_from_ymd(1895, 1, 1);
+    last  = dt_from_ymd(2105, 12, 31);
+
+    dt_cursor_init(&c, first);
+    good = check(&c, "init");
+    while (good && c.dt < last) {
+        dt_cursor_next(&c);
+        good = check(&c, "next");
+    }
+    ok(good, "dt_cursor_next() from 1895 through 2105");
+
+    good = true;
+    while (good && c.dt > first) {
+        dt_cursor_prev(&c);
+        good = check(&c, "prev");
+    }
+    ok(good, "dt_cursor_prev() from 2105 back to 1895");
+
+    state = 1;
+    good = true;
+    for (i = 0; good && i < 200000; i++) {
+        delta = (int)((next_rand(&state) >> 8) % 129) - 64;
+        if (c.dt + delta < first || c.dt + delta > last)
+            delta = -delta;
+        dt_cursor_add_days(&c, delta);
+        good = check(&c, "add_days");
+    }
+    ok(good, "dt_cursor_add_days() by up to 64 days either way");
+
+    good = true;
+    for (i = 0; good && i < 10000; i++) {
+        dt = dt_from_ymd(1, 1, 1) + (dt_t)((next_rand(&state) >> 4) % 3652059);
+        dt_cursor_set(&c, dt);
+        good = c.dt == dt && check(&c, "set");
+        dt_cursor_set(&c, dt + 7);
+        good = good && check(&c, "set near");
+    }
+    ok(good, "dt_cursor_set() from 0001 through 9999");
+
+    dt_cursor_init(&c, dt_from_ymd(2020, 12, 31));
+    dt_cursor_next(&c);
+    ok(c.year == 2021 && c.week_year == 2020 && c.week == 53 && c.dow == DT_FRIDAY && !c.leap,
+       "2021-01-01 is in week 53 of 2020");
+
+    done_testing();
+}
@@ -93,6 +93,19 @@ const struct test {
     {2013, 12, 26, 2013, 12, 24,    0, 1},
     {2011,  6,  1, 2014,  6,  1,  772, 1},
     {2014,  6,  1, 2011,  6,  1, -772, 1},
+    {2013,  3, 28, 2013,  3, 29,    0, 0},
+    {2013,  3, 28, 2013,  4,  2,    1, 0},
+    {2013,  3, 29, 2013,  4,  2,    0, 0},
+    {2013,  3, 29, 2013,  4,  1,    0, 0},
+    {2013,  4,  1, 2013,  4,  2,    0, 0},
+    {2013,  4,  1, 2013,  4,  3,    1, 0},
+    {2013,  4,  2, 2013,  3, 29,    0, 0},
+    {2013,  4,  2, 2013,  3, 28,   -1, 0},
+    {2013,  4,  2, 2013,  3, 27,   -2, 0},
+    {2013, 12, 23, 2013, 12, 27,    1, 0},
+    {2013, 12, 24, 2013, 12, 27,    0, 0},
+    {2013, 12, 27, 2013, 12, 23,   -1, 0},
+    {2013,  6,  1, 2013,  6,  7,    3, 0},
 };
 
 const struct ymd {
@@ -0,0 +1,227 @@
+#include <limits.h>
+#include "dt.h"
+#include "tap.h"
+#include "util.h"
+
+static int64_t
+floor_div(int64_t a, int64_t b) {
+    return a / b - (a % b < 0);
+}
+
+/* Reference: days before January 1 of year y, counted from 0001-01-01 */
+static int64_t
+days_before_year(int64_t y) {
+    y--;
+    return 365 * y + floor_div(y, 4) - floor_div(y, 100) + floor_div(y, 400);
+}
+
+static bool
+same_as_dt(dt_t dt) {
+    dt64_t dt64 = dt64_from_dt(dt);
+    int y1, a1, b1, y2, a2, b2;
+
+    dt_to_ymd(dt, &y1, &a1, &b1);
+    dt64_to_ymd(dt64, &y2, &a2, &b2);
+    if (y1 != y2 || a1 != a2 || b1 != b2 || dt64_from_ymd(y2, a2, b2) != dt64)
+        goto fail;
+
+    dt_to_yd(dt, &y1, &a1);
+    dt64_to_yd(dt64, &y2, &a2);
+    if (y1 != y2 || a1 != a2 || dt64_from_yd(y2, a2) != dt64)
+        goto fail;
+
+    dt_to_yqd(dt, &y1, &a1, &b1);
+    dt64_to_yqd(dt64, &y2, &a2, &b2);
+    if (y1 != y2 || a1 != a2 || b1 != b2 || dt64_from_yqd(y2, a2, b2) != dt64)
+        goto fail;
+
+    dt_to_ywd(dt, &y1, &a1, &b1);
+    dt64_to_ywd(dt64, &y2, &a2, &b2);
+    if (y1 != y2 || a1 != a2 || b1 != b2 || dt64_from_ywd(y2, a2, b2) != dt64)
+        goto fail;
+
+    if (dt_dow(dt) != dt64_dow(dt64))
+        goto fail;
+    return true;
+
+  fail:
+    diag("    dt: %d", dt);
+    return false;
+}
+
+/* Checks a date outside of the domain of the dt_t functions against the reference */
+static bool
+check_limit(dt64_t dt) {
+    int y, m, d, doy;
+
+    dt64_to_yd(dt, &y, &doy);
+    dt64_to_ymd(dt, NULL, &m, &d);
+    if (doy < 1 || doy > dt_days_in_year(y) ||
+        days_before_year(y) + doy + DT_EPOCH_OFFSET != dt ||
+        dt64_from_ymd(y, m, d) != dt) {
+        diag("    dt: %lld", (long long)dt);
+        return false;
+    }
+    return true;
+}
+
+static bool
+check_year(int y) {
+    dt64_t dt, exp;
+    int m, d, gy, gm, gd, gw;
+
+    exp = days_before_year(y) + 1 + DT_EPOCH_OFFSET;
+    dt = dt64_from_yd(y, 1);
+    if (dt != exp) {
+        diag("    dt64_from_yd(%d, 1)", y);
+        return false;
+    }
+    for (m = 1; m <= 12; m++) {
+        for (d = 1; d <= dt_days_in_month(y, m); d++, dt++) {
+            dt64_to_ymd(dt, &gy, &gm, &gd);
+            if (gy != y || gm != m || gd != d || dt64_from_ymd(y, m, d) != dt) {
+                diag("    got: %d-%.2d-%.2d", gy, gm, gd);
+                diag("    exp: %d-%.2d-%.2d", y, m, d);
+                return false;
+            }
+        }
+    }
+    if (dt != days_before_year((int64_t)y + 1) + 1 + DT_EPOCH_OFFSET)
+        return false;
+
+    /* 4 January is always in week 1 */
+    dt64_to_ywd(dt64_from_ymd(y, 1, 4), &gy, &gw, &gd);
+    if (gy != y || gw != 1 || dt64_from_ywd(y, 1, gd) != dt64_from_ymd(y, 1, 4))
+        return false;
+    return true;
+}
+
+/*
+ * The dt_t functions overflow for dates close to the limits of dt_t,
+ * compare against them only within +/- 5 million years.
+ */
+#define YEAR_MAX 5000000
+
+int
+main() {
+    unsigned int state;
+    int i;
+    bool good;
+
+    {
+        const dt_t lo = dt_from_ymd(-YEAR_MAX, 1, 1);
+        const dt_t hi = dt_from_ymd(YEAR_MAX, 12, 31);
+        const unsigned int span = (unsigned int)hi - (unsigned int)lo + 1;
+        dt_t dt;
+
+        good = true;
+        for (dt = dt_from_ymd(1600, 1, 1); good && dt <= dt_from_ymd(2400, 12, 31); dt++)
+            good = same_as_dt(dt);
+        ok(good, "dt64 matches dt_t (1600-01-01 .. 2400-12-31)");
+
+        state = 1;
+        for (i = 0; good && i < 1000000; i++)
+            good = same_as_dt((dt_t)((unsigned int)lo + next_rand(&state) % span));
+        ok(good, "dt64 matches dt_t (random)");
+
+        good = same_as_dt(lo) && same_as_dt(lo + 1) &&
+               same_as_dt(hi) && same_as_dt(hi - 1);
+        ok(good, "dt64 matches dt_t (-5000000-01-01, 5000000-12-31)");
+
+        good = check_limit(INT_MIN) && check_limit(INT_MIN + 1) &&
+               check_limit(INT_MAX) && check_limit(INT_MAX - 1);
+        ok(good, "dt64 at the limits of dt_t (INT_MIN, INT_MAX)");
+    }
+
+    {
+        static const int years[] = {
+            INT_MIN, INT_MIN + 1, -5879611, -5879610, -400, -1, 0, 1,
+            5879611, 5879612, 100000000, INT_MAX - 1, INT_MAX,
+        };
+
+        for (i = 0; i < (int)(sizeof(years) / sizeof(*years)); i++)
+            ok(check_year(years[i]), "dt64 year %d", years[i]);
+
+        state = 42;
+        good = true;
+        for (i = 0; good && i < 2000; i++)
+            good = check_year((int)next_rand(&state));
+        ok(good, "dt64 random years");
+    }
+
+    {
+        dt64_t dt1, dt2;
+        int y, w, d;
+
+        /* The week-based year is clamped to the range of an int */
+        dt1 = dt64_from_ymd(INT_MIN, 1, 1);
+        dt2 = dt64_from_ymd(INT_MAX, 12, 31);
+        good = true;
+        for (i = 0; good && i < 7; i++) {
+            dt64_to_ywd(dt1 + i, &y, &w, &d);
+            good = y == INT_MIN && d == dt64_dow(dt1 + i);
+            dt64_to_ywd(dt2 - i, &y, &w, &d);
+            good = good && y == INT_MAX && d == dt64_dow(dt2 - i);
+        }
+        ok(good, "dt64_to_ywd() at the limits of the year range");
+    }
+
+    {
+        dt_t dt = 0;
+
+        ok(dt64_to_dt(INT32_MAX, &dt) && dt == INT32_MAX, "dt64_to_dt(INT32_MAX)");
+        ok(dt64_to_dt(INT32_MIN, &dt) && dt == INT32_MIN, "dt64_to_dt(INT32_MIN)");
+        ok(!dt64_to_dt((dt64_t)INT32_MAX + 1, &dt), "dt64_to_dt(INT32_MAX + 1)");
+        ok(!dt64_to_dt((dt64_t)INT32_MIN - 1, &dt), "dt64_to_dt(INT32_MIN - 1)");
+        ok(dt64_rdn(dt64_from_rdn(INT64_C(1) << 40)) == INT64_C(1) << 40, "dt64_rdn()");
+    }
+
+    {
+        dt64_t dt1, dt2;
+
+        dt1 = dt64_from_ymd(5000000, 12, 31);
+        dt2 = dt64_add_years(dt1, 1000001, DT_LIMIT);
+        ok(dt2 == dt64_from_ymd(6000001, 12, 31), "dt64_add_years(DT_LIMIT)");
+        dt2 = dt64_add_years(dt1, 1000001, DT_EXCESS);
+        ok(dt2 == dt64_from_ymd(6000002, 1, 1), "dt64_add_years(DT_EXCESS)");
+        ok(dt64_delta_years(dt1, dt2, true) == 1000001, "dt64_delta_years()");
+
+        dt1 = dt64_from_ymd(-10000000, 1, 31);
+        dt2 = dt64_add_months(dt1, 13, DT_SNAP);
+        ok(dt2 == dt64_from_ymd(-9999999, 2, 28), "dt64_add_months(DT_SNAP)");
+        ok(dt64_delta_months(dt1, dt2, false) == 13, "dt64_delta_months()");
+        dt2 = dt64_add_months(dt1, INT_MAX, DT_LIMIT);
+        ok(dt64_delta_months(dt1, dt2, true) == INT_MAX, "dt64_add_months(INT_MAX)");
+        dt2 = dt64_add_months(dt1, INT_MIN, DT_LIMIT);
+        ok(dt64_delta_months(dt1, dt2, true) == INT_MIN, "dt64_add_months(INT_MIN)");
+
+        dt2 = dt64_add_quarters(dt1, -4 * 1000000 - 1, DT_LIMIT);
+        ok(dt2 == dt64_from_ymd(-11000001, 10, 31), "dt64_add_quarters()");
+        ok(dt64_delta_quarters(dt1, dt2, true) == -4 * 1000000 - 1, "dt64_delta_quarters()");
+
+        dt1 = dt64_from_ymd(INT_MIN, 1, 1);
+        dt2 = dt64_from_ymd(INT_MAX, 12, 31);
+        ok(dt64_delta_years(dt1, dt2, false) == (int64_t)INT_MAX - INT_MIN, "dt64_delta_years(INT_MIN, INT_MAX)");
+        ok(dt64_delta_weeks(dt1, dt2) == (dt2 - dt1) / 7, "dt64_delta_weeks(INT_MIN, INT_MAX)");
+
+        /* Normalized and shifted years beyond the range of an int, 400 years are 146097 days */
+        ok(dt64_from_ymd(INT_MAX, 13, 1) == dt2 + 1, "dt64_from_ymd(INT_MAX, 13, 1)");
+        ok(dt64_from_yqd(INT_MAX, 5, 1) == dt2 + 1, "dt64_from_yqd(INT_MAX, 5, 1)");
+        ok(dt64_from_ymd(INT_MAX, 12, INT_MAX) == dt2 + INT_MAX - 31, "dt64_from_ymd(INT_MAX, 12, INT_MAX)");
+        ok(dt64_from_ymd(INT_MIN, INT_MIN, 1) - dt64_from_ymd(INT_MIN, INT_MIN + 4800 * 447392, 1)
+           == -INT64_C(146097) * 447392, "dt64_from_ymd(INT_MIN, INT_MIN, 1)");
+        dt1 = dt64_from_ymd(INT_MAX - 1, 2, 29);
+        dt2 = dt64_add_years(dt1, 2147483600, DT_LIMIT);
+        ok(dt2 - dt1 == INT64_C(146097) * 5368709, "dt64_add_years(INT_MAX - 1, 2147483600)");
+        dt1 = dt64_from_ymd(INT_MAX, 12, 31);
+        dt2 = dt64_add_months(dt1, 4800 * 447392, DT_SNAP);
+        ok(dt2 - dt1 == INT64_C(146097) * 447392, "dt64_add_months(INT_MAX, 4800 * 447392)");
+        dt2 = dt64_add_quarters(dt1, 1600 * 1342177, DT_SNAP);
+        ok(dt2 - dt1 == INT64_C(146097) * 1342177, "dt64_add_quarters(INT_MAX, 1600 * 1342177)");
+        dt1 = dt64_from_ymd(INT_MIN, 1, 31);
+        dt2 = dt64_add_months(dt1, INT_MIN, DT_LIMIT);
+        ok(dt2 < dt1, "dt64_add_months(INT_MIN, INT_MIN)");
+    }
+
+    done_testing();
+}
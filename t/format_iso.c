@@ -0,0 +1,181 @@
+#include <limits.h>
+#include <stdio.h>
+#include <string.h>
+#include "dt.h"
+#include "tap.h"
+#include "util.h"
+
+typedef size_t (*format_fn)(char *, size_t, dt_t);
+
+const struct date_t {
+    int y;
+    int m;
+    int d;
+    format_fn fn;
+    const char *name;
+    const char *exp;
+} dates[] = {
+    { 2012, 12, 24, dt_format_iso_date,               "date",               "2012-12-24"   },
+    { 2012, 12, 24, dt_format_iso_date_basic,         "date_basic",         "20121224"     },
+    { 2012, 12, 24, dt_format_iso_ordinal_date,       "ordinal_date",       "2012-359"     },
+    { 2012, 12, 24, dt_format_iso_ordinal_date_basic, "ordinal_date_basic", "2012359"      },
+    { 2012, 12, 24, dt_format_iso_week_date,          "week_date",          "2012-W52-1"   },
+    { 2012, 12, 24, dt_format_iso_week_date_basic,    "week_date_basic",    "2012W521"     },
+    { 2012, 12, 24, dt_format_iso_quarter_date,       "quarter_date",       "2012-Q4-85"   },
+    { 2012, 12, 24, dt_format_iso_quarter_date_basic, "quarter_date_basic", "2012Q485"     },
+    { 2013,  1,  1, dt_format_iso_ordinal_date,       "ordinal_date",       "2013-001"     },
+    { 2010,  1,  3, dt_format_iso_week_date,          "week_date",          "2009-W53-7"   },
+    {    1,  1,  1, dt_format_iso_date,               "date",               "0001-01-01"   },
+    {    0,  1,  1, dt_format_iso_date,               "date",               "0000-01-01"   },
+    {   -1, 12, 31, dt_format_iso_date,               "date",               "-0001-12-31"  },
+    {10000,  1,  1, dt_format_iso_date,               "date",               "+10000-01-01" },
+    {-5000000, 1,  1, dt_format_iso_date,             "date",               "-5000000-01-01" },
+    { 5000000, 1,  1, dt_format_iso_week_date,        "week_date",          "+4999999-W52-6" },
+};
+
+const struct hms_t {
+    int sod;
+    int nsec;
+    int precision;
+    int offset;
+    const char *exp;
+} times[] = {
+    {     0,         0, 0,     0, "00:00:00Z"                },
+    { 45045, 123456789, 3,    60, "12:30:45.123+01:00"       },
+    { 45045, 123456789, 9,  -330, "12:30:45.123456789-05:30" },
+    { 45045,    500000, 4, -1439, "12:30:45.0005-23:59"      },
+    { 86399, 999999999, 1,  1439, "23:59:59.9+23:59"         },
+    { 86400,         0, 0,     0, "24:00:00Z"                },
+};
+
+int
+main() {
+    char buf[64];
+    int i, ntests;
+    size_t n;
+
+    ntests = sizeof(dates) / sizeof(*dates);
+    for (i = 0; i < ntests; i++) {
+        const struct date_t t = dates[i];
+
+        n = t.fn(buf, sizeof(buf), dt_from_ymd(t.y, t.m, t.d));
+        ok(n == strlen(t.exp), "dt_format_iso_%s() size_t: %d", t.name, (int)n);
+        is(buf, t.exp, "dt_format_iso_%s(%d-%d-%d)", t.name, t.y, t.m, t.d);
+
+        n = t.fn(buf, strlen(t.exp), dt_from_ymd(t.y, t.m, t.d));
+        ok(n == 0, "dt_format_iso_%s() without room for NUL", t.name);
+    }
+
+    ntests = sizeof(times) / sizeof(*times);
+    for (i = 0; i < ntests; i++) {
+        const struct hms_t t = times[i];
+        char exp[64];
+
+        n = dt_format_iso_time(buf, sizeof(buf), t.sod, t.nsec, t.precision);
+        n += dt_format_iso_zone(buf + n, sizeof(buf) - n, t.offset);
+        is(buf, t.exp, "dt_format_iso_time/zone(%d, %d, %d, %d)", t.sod, t.nsec, t.precision, t.offset);
+
+        snprintf(exp, sizeof(exp), "2012-12-24T%s", t.exp);
+        n = dt_format_iso_datetime(buf, sizeof(buf), dt_from_ymd(2012, 12, 24),
+                                   t.sod, t.nsec, t.precision, t.offset);
+        ok(n == strlen(exp), "dt_format_iso_datetime() size_t: %d", (int)n);
+        is(buf, exp, "dt_format_iso_datetime(%s)", exp);
+    }
+
+    n = dt_format_iso_time_basic(buf, sizeof(buf), 45045, 120000000, 2);
+    is(buf, "123045.12", "dt_format_iso_time_basic()");
+    n = dt_format_iso_zone_basic(buf, sizeof(buf), -330);
+    is(buf, "-0530", "dt_format_iso_zone_basic()");
+
+    ok(dt_format_iso_time(buf, sizeof(buf), -1, 0, 0) == 0, "dt_format_iso_time(-1)");
+    ok(dt_format_iso_time(buf, sizeof(buf), 86401, 0, 0) == 0, "dt_format_iso_time(86401)");
+    ok(dt_format_iso_time_basic(buf, sizeof(buf), 0, 1000000000, 9) == 0, "dt_format_iso_time_basic(0, 1000000000)");
+    ok(dt_format_iso_zone(buf, sizeof(buf), 1440) == 0, "dt_format_iso_zone(1440)");
+    ok(dt_format_iso_zone_basic(buf, sizeof(buf), INT_MIN) == 0, "dt_format_iso_zone_basic(INT_MIN)");
+    ok(dt_format_iso_datetime(buf, sizeof(buf), dt_from_ymd(2012, 12, 24), 360000, 0, 0, 0) == 0,
+       "dt_format_iso_datetime() with sod 360000");
+    ok(dt_format_iso_datetime(buf, sizeof(buf), dt_from_ymd(2012, 12, 24), 0, 0, 0, -6000) == 0,
+       "dt_format_iso_datetime() with offset -6000");
+
+    {
+        static const format_fn fns[] = {
+            dt_format_iso_date,         dt_format_iso_date_basic,
+            dt_format_iso_ordinal_date, dt_format_iso_ordinal_date_basic,
+            dt_format_iso_week_date,    dt_format_iso_week_date_basic,
+            dt_format_iso_quarter_date, dt_format_iso_quarter_date_basic,
+        };
+        char exp[64];
+        dt_t dt, got;
+        bool good = true;
+        int y, m, d;
+
+        for (dt = dt_from_ymd(1, 1, 1); good && dt <= dt_from_ymd(9999, 12, 31); dt++) {
+            for (i = 0; good && i < 8; i++) {
+#ifdef DT_PARSE_ISO_STRICT
+                if (i >= 6)
+                    break;
+#endif
+                n = fns[i](buf, sizeof(buf), dt);
+                got = 0;
+                if (dt_parse_iso_date(buf, n, &got) != n || got != dt) {
+                    diag("    dt: %d str: %s", dt, buf);
+                    good = false;
+                }
+            }
+            dt_to_ymd(dt, &y, &m, &d);
+            snprintf(exp, sizeof(exp), "%04d-%02d-%02d", y, m, d);
+            dt_format_iso_date(buf, sizeof(buf), dt);
+            if (strcmp(buf, exp) != 0) {
+                diag("    dt: %d got: %s exp: %s", dt, buf, exp);
+                good = false;
+            }
+        }
+        ok(good, "dt_parse_iso_date(dt_format_iso_*()) round-trips (0001-01-01 .. 9999-12-31)");
+    }
+
+    {
+        /* dt_to_ymd() overflows close to the limits of dt_t */
+        const dt_t lo = dt_from_ymd(-5000000, 1, 1);
+        const dt_t hi = dt_from_ymd(5000000, 12, 31);
+        const unsigned int span = (unsigned int)hi - (unsigned int)lo + 1;
+        unsigned int state = 1;
+        dt64_t got;
+        dt_t dt;
+        bool good = true;
+
+        for (i = 0; good && i < 100000; i++) {
+            dt = (dt_t)((unsigned int)lo + next_rand(&state) % span);
+            n = dt_format_iso_date(buf, sizeof(buf), dt);
+            if (dt64_parse_iso_date(buf, n, &got) != n || got != dt) {
+                diag("    dt: %d str: %s", dt, buf);
+                good = false;
+            }
+        }
+        ok(good, "dt64_parse_iso_date(dt_format_iso_date()) round-trips (random)");
+    }
+
+    {
+        unsigned int state = 1, r;
+        dt_t dt, gdt;
+        int sod, nsec, offset, gsod, gnsec, goffset;
+        bool good = true;
+
+        for (i = 0; good && i < 100000; i++) {
+            r = next_rand(&state);
+            dt = dt_from_ymd(1970, 1, 1) + (int)(r % 47847);
+            sod = (int)(r >> 8) % 86400;
+            r = next_rand(&state);
+            nsec = (int)(r % 1000000000);
+            offset = (int)(r >> 20) % 2879 - 1439;
+            n = dt_format_iso_datetime(buf, sizeof(buf), dt, sod, nsec, 9, offset);
+            if (dt_parse_iso_datetime(buf, n, &gdt, &gsod, &gnsec, &goffset) != n ||
+                gdt != dt || gsod != sod || gnsec != nsec || goffset != offset) {
+                diag("    str: %s", buf);
+                good = false;
+            }
+        }
+        ok(good, "dt_parse_iso_datetime(dt_format_iso_datetime()) round-trips");
+    }
+
+    done_testing();
+}
@@ -0,0 +1,135 @@
+#include "dt.h"
+#include "tap.h"
+#include <string.h>
+#include <time.h>
+
+const struct good_t {
+    const char *pattern;
+    int y, m, d;
+    int sod;
+    int nsec;
+    int offset;
+    const char *exp;
+} good[] = {
+    { "%Y-%m-%d",               2012, 12, 24,     0,         0,    0, "2012-12-24"                      },
+    { "%F %T",                  2012, 12, 24, 45045,         0,    0, "2012-12-24 12:30:45"             },
+    { "%Y%m%dT%H%M%S",          2012, 12, 24, 45045,         0,    0, "20121224T123045"                 },
+    { "%D %R",                  2012,  2,  1,  3600,         0,    0, "02/01/12 01:00"                  },
+    { "%e %b %Y",               2012,  2,  1,     0,         0,    0, " 1 Feb 2012"                     },
+    { "%e %B %Y",               2012,  9, 24,     0,         0,    0, "24 September 2012"               },
+    { "%a %A %u %w",            2012, 12, 23,     0,         0,    0, "Sun Sunday 7 0"                  },
+    { "%a %A %u %w",            2012, 12, 24,     0,         0,    0, "Mon Monday 1 1"                  },
+    { "%j",                     2012, 12, 31,     0,         0,    0, "366"                             },
+    { "%j",                     2013,  1,  9,     0,         0,    0, "009"                             },
+    { "%G-W%V-%u",              2008, 12, 29,     0,         0,    0, "2009-W01-1"                      },
+    { "%G-W%V-%u",              2010,  1,  3,     0,         0,    0, "2009-W53-7"                      },
+    { "%I:%M %p",               2012, 12, 24,     0,         0,    0, "12:00 AM"                        },
+    { "%I:%M %p",               2012, 12, 24, 43200,         0,    0, "12:00 PM"                        },
+    { "%I:%M %p",               2012, 12, 24, 48600,         0,    0, "01:30 PM"                        },
+    { "%T.%f",                  2012, 12, 24, 45045, 123456789,    0, "12:30:45.123456789"              },
+    { "%T.%3f",                 2012, 12, 24, 45045, 123456789,    0, "12:30:45.123"                    },
+    { "%T.%1f",                 2012, 12, 24, 45045, 987654321,    0, "12:30:45.9"                      },
+    { "%T.%6f",                 2012, 12, 24, 45045,      1000,    0, "12:30:45.000001"                 },
+    { "%z",                     2012, 12, 24,     0,         0,    0, "+0000"                           },
+    { "%z",                     2012, 12, 24,     0,         0,   60, "+0100"                           },
+    { "%:z",                    2012, 12, 24,     0,         0, -330, "-05:30"                          },
+    { "%FT%T%:z",               2012, 12, 24, 45045,         0, 1439, "2012-12-24T12:30:45+23:59"       },
+    { "%Y",                       99,  1,  1,     0,         0,    0, "0099"                            },
+    { "%Y %y",                 12345,  1,  1,     0,         0,    0, "12345 45"                        },
+    { "%Y %y",                   -12,  1,  1,     0,         0,    0, "-0012 88"                        },
+    { "100%% %n%t",             2012, 12, 24,     0,         0,    0, "100% \n\t"                       },
+    { "",                       2012, 12, 24,     0,         0,    0, ""                                },
+    { "%a, %d %b %Y %T %z",     2012, 12, 24, 45045,         0,  -60, "Mon, 24 Dec 2012 12:30:45 -0100" },
+};
+
+const char *bad_patterns[] = {
+    "%Q",
+    "%",
+    "%:",
+    "%:Y",
+    "%0f",
+    "%3",
+    "%3Y",
+    "%F %T %F %T %F %T %F %T %F %T %F %T %F %T",
+    "................................................................",
+};
+
+/* Compares the conversions shared with strftime() over a range of dates and times */
+static bool
+check_strftime(const char *pattern) {
+    dt_format_pattern_t pat;
+    struct tm tm;
+    char got[100], exp[100];
+    dt_t dt;
+    int sod;
+
+    if (!dt_format_pattern_compile(&pat, pattern))
+        return false;
+    for (dt = dt_from_ymd(1899, 12, 20), sod = 0; dt < dt_from_ymd(2101, 1, 10); dt += 3, sod = (sod + 4111) % 86400) {
+        memset(&tm, 0, sizeof(tm));
+        dt_to_struct_tm(dt, &tm);
+        tm.tm_hour = sod / 3600;
+        tm.tm_min  = sod / 60 % 60;
+        tm.tm_sec  = sod % 60;
+        strftime(exp, sizeof(exp), pattern, &tm);
+        dt_format_pattern(&pat, got, sizeof(got), dt, sod, 0, 0);
+        if (strcmp(got, exp) != 0) {
+            diag("dt_format_pattern(%s) = '%s', exp '%s'", pattern, got, exp);
+            return false;
+        }
+    }
+    return true;
+}
+
+int
+main() {
+    dt_format_pattern_t pat;
+    char buf[100];
+    int i, ntests;
+    size_t n;
+
+    ntests = sizeof(good) / sizeof(*good);
+    for (i = 0; i < ntests; i++) {
+        const struct good_t t = good[i];
+
+        if (!ok(dt_format_pattern_compile(&pat, t.pattern), "dt_format_pattern_compile(%s)", t.pattern))
+            continue;
+        n = dt_format_pattern(&pat, buf, sizeof(buf), dt_from_ymd(t.y, t.m, t.d), t.sod, t.nsec, t.offset);
+        is(buf, t.exp, "dt_format_pattern(%s)", t.pattern);
+        cmp_ok((int)n, "==", (int)strlen(t.exp), "dt_format_pattern(%s) size_t", t.pattern);
+    }
+
+    ntests = sizeof(bad_patterns) / sizeof(*bad_patterns);
+    for (i = 0; i < ntests; i++)
+        ok(!dt_format_pattern_compile(&pat, bad_patterns[i]), "!dt_format_pattern_compile(%s)", bad_patterns[i]);
+
+    ok(check_strftime("%Y-%m-%d %H:%M:%S"), "dt_format_pattern() agrees with strftime() on numbers");
+    ok(check_strftime("%a %A %b %B %h %e %j %u %w"), "dt_format_pattern() agrees with strftime() on names and days");
+    ok(check_strftime("%G-W%V-%u %D %R %T %I %p %y"), "dt_format_pattern() agrees with strftime() on weeks and times");
+
+    /* A destination that is too small */
+    dt_format_pattern_compile(&pat, "%F");
+    n = dt_format_pattern(&pat, buf, 11, dt_from_ymd(2012, 12, 24), 0, 0, 0);
+    ok(n == 10 && strcmp(buf, "2012-12-24") == 0, "dt_format_pattern(%%F) fits in 11");
+    n = dt_format_pattern(&pat, buf, 10, dt_from_ymd(2012, 12, 24), 0, 0, 0);
+    ok(n == 0, "dt_format_pattern(%%F) does not fit in 10");
+    ok(dt_format_pattern(&pat, NULL, 0, dt_from_ymd(2012, 12, 24), 0, 0, 0) == 0,
+       "dt_format_pattern(%%F) into an empty destination");
+
+    /* The time and offset are validated only when the pattern uses them */
+    n = dt_format_pattern(&pat, buf, sizeof(buf), dt_from_ymd(2012, 12, 24), -1, -1, 6000);
+    ok(n == 10, "dt_format_pattern(%%F) ignores the time and offset");
+    dt_format_pattern_compile(&pat, "%H:%M");
+    ok(dt_format_pattern(&pat, buf, sizeof(buf), 0, 360000, 0, 0) == 0, "dt_format_pattern(%%H) with sod 360000");
+    ok(dt_format_pattern(&pat, buf, sizeof(buf), 0, -1, 0, 0) == 0, "dt_format_pattern(%%H) with sod -1");
+    n = dt_format_pattern(&pat, buf, sizeof(buf), 0, 86400, 0, 0);
+    ok(n == 5 && strcmp(buf, "24:00") == 0, "dt_format_pattern(%%H) with sod 86400");
+    dt_format_pattern_compile(&pat, "%3f");
+    ok(dt_format_pattern(&pat, buf, sizeof(buf), 0, 0, 1000000000, 0) == 0, "dt_format_pattern(%%3f) with nsec 1000000000");
+    dt_format_pattern_compile(&pat, "%z");
+    ok(dt_format_pattern(&pat, buf, sizeof(buf), 0, 0, 0, -6000) == 0, "dt_format_pattern(%%z) with offset -6000");
+    n = dt_format_pattern(&pat, buf, sizeof(buf), 0, 0, 0, -1439);
+    ok(n == 5 && strcmp(buf, "-2359") == 0, "dt_format_pattern(%%z) with offset -1439");
+
+    done_testing();
+}
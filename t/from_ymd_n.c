@@ -0,0 +1,165 @@
+#include "dt.h"
+#include "dt_simd.h"
+#include "tap.h"
+#include "util.h"
+
+#define N 4096
+
+/*
+ * dt_from_ymd() and dt_from_yd() overflow for years close to the limits
+ * of dt_t, compare against them only within +/- 5 million years and use
+ * the 64-bit functions as the reference for every date that fits in a
+ * dt_t. The vector lanes are defined for every year, the scalar code the
+ * portable build falls back to is not.
+ */
+#define YEAR_MAX 5000000
+#ifdef DT_SIMD_SSE2
+#  define YEAR_SPAN 5879610
+#else
+#  define YEAR_SPAN YEAR_MAX
+#endif
+
+static int ys[N], ms[N], ds[N];
+static dt_t dst[N];
+
+static bool
+in_scalar_range(int y) {
+    return y >= -YEAR_MAX && y <= YEAR_MAX;
+}
+
+static bool
+compare(size_t i, dt64_t ref, dt_t (*scalar)(size_t)) {
+    dt_t exp;
+
+    if (!dt64_to_dt(ref, &exp))
+        return true;
+    if (in_scalar_range(ys[i]) && scalar(i) != exp) {
+        diag(" scalar: %d", scalar(i));
+        diag("    exp: %d", exp);
+        return false;
+    }
+    if (dst[i] != exp) {
+        diag("    got: %d", dst[i]);
+        diag("    exp: %d", exp);
+        return false;
+    }
+    return true;
+}
+
+static dt_t
+scalar_ymd(size_t i) {
+    return dt_from_ymd(ys[i], ms[i], ds[i]);
+}
+
+static dt_t
+scalar_yd(size_t i) {
+    return dt_from_yd(ys[i], ds[i]);
+}
+
+static bool
+compare_ymd(size_t n) {
+    size_t i;
+
+    for (i = 0; i < n; i++) {
+        if (!compare(i, dt64_from_ymd(ys[i], ms[i], ds[i]), scalar_ymd)) {
+            diag("  input: %d, %d, %d", ys[i], ms[i], ds[i]);
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool
+compare_yd(size_t n) {
+    size_t i;
+
+    for (i = 0; i < n; i++) {
+        if (!compare(i, dt64_from_yd(ys[i], ds[i]), scalar_yd)) {
+            diag("  input: %d, %d", ys[i], ds[i]);
+            return false;
+        }
+    }
+    return true;
+}
+
+int
+main() {
+    unsigned int state;
+    size_t i, n;
+    bool good;
+
+    {
+        dt_t dt = dt_from_ymd(1600, 1, 1);
+        good = true;
+        while (good && dt < dt_from_ymd(2400, 12, 31)) {
+            for (i = 0; i < N; i++)
+                dt_to_ymd(dt++, &ys[i], &ms[i], &ds[i]);
+            dt_from_ymd_n(ys, ms, ds, N, dst);
+            good = compare_ymd(N);
+        }
+        ok(good, "dt_from_ymd_n(1600-01-01 .. 2400-12-31)");
+    }
+
+    {
+        state = 1;
+        good = true;
+        for (n = 0; good && n < 500; n++) {
+            for (i = 0; i < N; i++) {
+                ys[i] = (int)((next_rand(&state) >> 1) % (2 * YEAR_SPAN + 1)) - YEAR_SPAN;
+                ms[i] = (int)((next_rand(&state) >> 1) % 12) + 1;
+                ds[i] = (int)((next_rand(&state) >> 1) % 28) + 1;
+            }
+            dt_from_ymd_n(ys, ms, ds, N, dst);
+            good = compare_ymd(N);
+        }
+        ok(good, "dt_from_ymd_n(random dates)");
+    }
+
+    {
+        state = 2;
+        good = true;
+        for (n = 0; good && n < 100; n++) {
+            for (i = 0; i < N; i++) {
+                ys[i] = (int)((next_rand(&state) >> 1) % 4001) - 2000;
+                ms[i] = (int)((next_rand(&state) >> 1) % 61) - 30;
+                ds[i] = (int)((next_rand(&state) >> 1) % 61) - 30;
+            }
+            dt_from_ymd_n(ys, ms, ds, N, dst);
+            good = compare_ymd(N);
+        }
+        ok(good, "dt_from_ymd_n(unnormalised months and days)");
+    }
+
+    {
+        state = 3;
+        good = true;
+        for (n = 0; good && n < 500; n++) {
+            for (i = 0; i < N; i++) {
+                ys[i] = (int)((next_rand(&state) >> 1) % (2 * YEAR_SPAN + 1)) - YEAR_SPAN;
+                ds[i] = (int)((next_rand(&state) >> 1) % 1001) - 500;
+            }
+            dt_from_yd_n(ys, ds, N, dst);
+            good = compare_yd(N);
+        }
+        ok(good, "dt_from_yd_n(random dates)");
+    }
+
+    {
+        good = true;
+        for (n = 0; good && n < 20; n++) {
+            for (i = 0; i < N; i++) {
+                ys[i] = 2012;
+                ms[i] = 12;
+                ds[i] = (int)i + 1;
+                dst[i] = -1;
+            }
+            dt_from_ymd_n(ys, ms, ds, n, dst);
+            good = compare_ymd(n) && dst[n] == -1;
+            dt_from_yd_n(ys, ds, n, dst);
+            good = good && compare_yd(n) && dst[n] == -1;
+        }
+        ok(good, "dt_from_ymd_n() and dt_from_yd_n() respect the length for n < 20");
+    }
+
+    done_testing();
+}
@@ -0,0 +1,165 @@
+#include "dt.h"
+#include "tap.h"
+
+/* US federal holidays */
+static const dt_holiday_rule_t us[] = {
+    DT_HOLIDAY_FIXED(1, 1, DT_OBSERVE_NEAREST),
+    { DT_RULE_NTH_DOW, 1, 3, DT_MONDAY, DT_WESTERN, DT_OBSERVE_ACTUAL, 1986, 0 },
+    DT_HOLIDAY_NTH_DOW(2, 3, DT_MONDAY),
+    DT_HOLIDAY_NTH_DOW(5, -1, DT_MONDAY),
+    { DT_RULE_FIXED, 6, 19, DT_MONDAY, DT_WESTERN, DT_OBSERVE_NEAREST, 2021, 0 },
+    DT_HOLIDAY_FIXED(7, 4, DT_OBSERVE_NEAREST),
+    DT_HOLIDAY_NTH_DOW(9, 1, DT_MONDAY),
+    DT_HOLIDAY_NTH_DOW(10, 2, DT_MONDAY),
+    DT_HOLIDAY_FIXED(11, 11, DT_OBSERVE_NEAREST),
+    DT_HOLIDAY_NTH_DOW(11, 4, DT_THURSDAY),
+    DT_HOLIDAY_FIXED(12, 25, DT_OBSERVE_NEAREST),
+};
+
+/* Bank holidays in England and Wales */
+static const dt_holiday_rule_t uk[] = {
+    DT_HOLIDAY_FIXED(12, 26, DT_OBSERVE_SUBSTITUTE),
+    DT_HOLIDAY_FIXED(12, 25, DT_OBSERVE_SUBSTITUTE),
+    DT_HOLIDAY_FIXED(1, 1, DT_OBSERVE_SUBSTITUTE),
+    DT_HOLIDAY_EASTER(-2, DT_WESTERN),
+    DT_HOLIDAY_EASTER(1, DT_WESTERN),
+    DT_HOLIDAY_NTH_DOW(5, 1, DT_MONDAY),
+    DT_HOLIDAY_NTH_DOW(5, -1, DT_MONDAY),
+    DT_HOLIDAY_NTH_DOW(8, -1, DT_MONDAY),
+    { DT_RULE_FIXED, 6, 3, DT_MONDAY, DT_WESTERN, DT_OBSERVE_ACTUAL, 2022, 2022 },
+};
+
+#define COUNT(a) (sizeof(a) / sizeof(*a))
+
+static const struct {
+    const char *name;
+    int y;
+    int days[13][2];
+} years[] = {
+    { "US", 2021, { {1, 1}, {1, 18}, {2, 15}, {5, 31}, {6, 18}, {7, 5}, {9, 6},
+                    {10, 11}, {11, 11}, {11, 25}, {12, 24}, {12, 31} } },
+    { "US", 2022, { {1, 17}, {2, 21}, {5, 30}, {6, 20}, {7, 4}, {9, 5}, {10, 10},
+                    {11, 11}, {11, 24}, {12, 26} } },
+    { "US", 1985, { {1, 1}, {2, 18}, {5, 27}, {7, 4}, {9, 2}, {10, 14}, {11, 11},
+                    {11, 28}, {12, 25} } },
+    { "UK", 2016, { {1, 1}, {3, 25}, {3, 28}, {5, 2}, {5, 30}, {8, 29}, {12, 26},
+                    {12, 27} } },
+    { "UK", 2021, { {1, 1}, {4, 2}, {4, 5}, {5, 3}, {5, 31}, {8, 30}, {12, 27},
+                    {12, 28} } },
+    { "UK", 2022, { {1, 3}, {4, 15}, {4, 18}, {5, 2}, {5, 30}, {6, 3}, {8, 29},
+                    {12, 26}, {12, 27} } },
+};
+
+static void
+check_year(dt_holidays_t *h, const char *name, int y, const int days[][2]) {
+    const dt_t *got;
+    size_t i, n, exp;
+    bool good;
+
+    for (exp = 0; exp < 13 && days[exp][0]; exp++)
+        ;
+    got = dt_holidays_in_year(h, y, &n);
+    good = got && n == exp;
+    for (i = 0; good && i < n; i++)
+        good = got[i] == dt_from_ymd(y, days[i][0], days[i][1]);
+    ok(good, "%s %d: %d holidays", name, y, (int)exp);
+    if (!good && got) {
+        for (i = 0; i < n; i++) {
+            int m, d;
+            dt_to_ymd(got[i], NULL, &m, &d);
+            diag("got %02d-%02d", m, d);
+        }
+    }
+}
+
+int
+main() {
+    static const dt_holiday_rule_t bad = { DT_RULE_NTH_DOW, 1, 6, DT_MONDAY, DT_WESTERN, DT_OBSERVE_ACTUAL, 0, 0 };
+    static const dt_holiday_rule_t eve = DT_HOLIDAY_FIXED(12, 31, DT_OBSERVE_ACTUAL);
+    static const dt_holiday_rule_t gulf[] = {
+        DT_HOLIDAY_FIXED(12, 2, DT_OBSERVE_NEAREST),
+        DT_HOLIDAY_FIXED(12, 3, DT_OBSERVE_NEAREST),
+    };
+    dt_holidays_t *h, *g;
+    dt_calendar_t *cal;
+    const dt_t *first;
+    dt_t buf[4000];
+    dt_t dt, lo, hi;
+    size_t i, n, total;
+    int count, y;
+    bool good;
+
+    ok(dt_holidays_new(&bad, 1, DT_WEEKEND_DEFAULT) == NULL, "dt_holidays_new() rejects a sixth Monday");
+    ok(dt_holidays_new(us, COUNT(us), DT_WEEKEND_ALL) == NULL, "dt_holidays_new() rejects DT_WEEKEND_ALL");
+    dt_holidays_free(NULL);
+
+    /* 0000-12-31 is day 0 and a Sunday, a workday with a Friday and Saturday weekend */
+    h = dt_holidays_new(&eve, 1, DT_WEEKEND(DT_FRIDAY) | DT_WEEKEND(DT_SATURDAY));
+    first = dt_holidays_in_year(h, 0, &n);
+    ok(first && n == 1 && first[0] == 0, "a rule on 0000-12-31");
+    dt_holidays_free(h);
+
+    h = dt_holidays_new(us, COUNT(us), DT_WEEKEND_DEFAULT);
+    g = dt_holidays_new(uk, COUNT(uk), DT_WEEKEND_DEFAULT);
+    ok(h && g, "dt_holidays_new()");
+
+    for (i = 0; i < COUNT(years); i++)
+        check_year(years[i].name[1] == 'S' ? h : g, years[i].name, years[i].y, years[i].days);
+
+    /* Cached years keep their arrays while the window grows both ways */
+    first = dt_holidays_in_year(h, 2021, &n);
+    for (y = 1700; y <= 2300; y += 37)
+        dt_holidays_in_year(h, y, NULL);
+    ok(dt_holidays_in_year(h, 2021, &n) == first && n == 12, "cached years stay in place");
+
+    /* Every year is sorted, unique, within the year and on weekdays */
+    good = true;
+    total = 0;
+    for (y = 1800; good && y <= 2200; y++) {
+        first = dt_holidays_in_year(g, y, &n);
+        lo = dt_from_yd(y, 1);
+        hi = dt_from_yd(y + 1, 0);
+        for (i = 0; good && i < n; i++) {
+            good = first[i] >= lo && first[i] <= hi && dt_is_weekday(first[i])
+                && (!i || first[i - 1] < first[i]);
+        }
+        total += n;
+    }
+    ok(good, "UK 1800-2200: sorted, unique weekdays within each year");
+
+    lo = dt_from_ymd(1800, 1, 1);
+    hi = dt_from_ymd(2200, 12, 31);
+    count = dt_holidays_between(g, lo, hi, NULL, 0);
+    cmp_ok(count, "==", (int)total, "dt_holidays_between() counts every year");
+    count = dt_holidays_between(g, lo, hi, buf, 4000);
+    good = count == (int)total;
+    for (i = 1; good && i < (size_t)count; i++)
+        good = buf[i - 1] < buf[i];
+    ok(good, "dt_holidays_between() fills a sorted array");
+    cmp_ok(dt_holidays_between(g, dt_from_ymd(2021, 12, 28), dt_from_ymd(2022, 1, 3), buf, 1),
+           "==", 2, "dt_holidays_between() across a year end");
+    cmp_ok(buf[0], "==", dt_from_ymd(2021, 12, 28), "dt_holidays_between() stops at size");
+
+    /* A calendar from the rules agrees with the array */
+    lo = dt_from_ymd(2000, 1, 1);
+    hi = dt_from_ymd(2049, 12, 31);
+    count = dt_holidays_between(h, lo, hi, buf, 4000);
+    cal = dt_holidays_calendar(h, lo, hi);
+    good = cal != NULL;
+    for (dt = lo; good && dt <= hi; dt++)
+        good = dt_calendar_is_workday(cal, dt) == dt_is_workday(dt, buf, (size_t)count);
+    ok(good, "dt_holidays_calendar() agrees with dt_holidays_between()");
+    dt_calendar_free(cal);
+
+    dt_holidays_free(h);
+    dt_holidays_free(g);
+
+    /* Friday and Saturday weekend, 2011-12-02 is a Friday */
+    h = dt_holidays_new(gulf, COUNT(gulf), DT_WEEKEND(DT_FRIDAY) | DT_WEEKEND(DT_SATURDAY));
+    first = dt_holidays_in_year(h, 2011, &n);
+    ok(n == 2 && first[0] == dt_from_ymd(2011, 12, 1) && first[1] == dt_from_ymd(2011, 12, 4),
+       "friday and saturday: nearest weekdays are Thursday and Sunday");
+    dt_holidays_free(h);
+
+    done_testing();
+}
@@ -0,0 +1,79 @@
+#include <limits.h>
+#include "dt.h"
+#include "tap.h"
+#include "util.h"
+
+#define N 300
+
+static dt_t dates[N];
+
+/* Compares the searches against a linear scan for keys around each date */
+static bool
+check(size_t n, const char *name) {
+    const dt_t *end;
+    size_t i, j, lo, up;
+    dt_t keys[3];
+    int k;
+
+    end = dates + n;
+    for (i = 0; i <= n; i++) {
+        keys[0] = i < n ? dates[i] : INT_MAX;
+        keys[1] = keys[0] == INT_MIN ? keys[0] : keys[0] - 1;
+        keys[2] = keys[0] == INT_MAX ? keys[0] : keys[0] + 1;
+        for (k = 0; k < 3; k++) {
+            for (lo = 0; lo < n && dates[lo] < keys[k]; lo++)
+                ;
+            for (up = lo; up < n && dates[up] <= keys[k]; up++)
+                ;
+            j = (size_t)(dt_lower_bound(keys[k], dates, end) - dates);
+            if (j != lo) {
+                diag("%s, n = %d: dt_lower_bound(%d) = %d, exp %d", name, (int)n, keys[k], (int)j, (int)lo);
+                return false;
+            }
+            j = (size_t)(dt_upper_bound(keys[k], dates, end) - dates);
+            if (j != up) {
+                diag("%s, n = %d: dt_upper_bound(%d) = %d, exp %d", name, (int)n, keys[k], (int)j, (int)up);
+                return false;
+            }
+            if (dt_binary_search(keys[k], dates, end) != (up > lo)) {
+                diag("%s, n = %d: dt_binary_search(%d)", name, (int)n, keys[k]);
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+int
+main() {
+    unsigned int state;
+    size_t i, n;
+    bool good;
+
+    state = 1;
+    dates[0] = 735000;
+    for (i = 1; i < N; i++)
+        dates[i] = dates[i - 1] + (dt_t)((next_rand(&state) >> 8) % 3);
+
+    good = true;
+    for (n = 0; good && n <= N; n++)
+        good = check(n, "repeats");
+    ok(good, "every size up to %d, with repeated dates", N);
+
+    for (i = 0; i < N; i++)
+        dates[i] = 735000 + 2 * (dt_t)i;
+    good = true;
+    for (n = 0; good && n <= N; n++)
+        good = check(n, "unique");
+    ok(good, "every size up to %d, unique dates", N);
+
+    dates[0] = INT_MIN;
+    dates[1] = INT_MIN + 1;
+    dates[2] = -1;
+    dates[3] = 0;
+    dates[4] = INT_MAX - 1;
+    dates[5] = INT_MAX;
+    ok(check(6, "limits"), "dates at the limits of dt_t");
+
+    done_testing();
+}
@@ -0,0 +1,91 @@
+#include "dt.h"
+#include "tap.h"
+#include "util.h"
+
+#define N 1000
+#define K 600
+
+static dt_t dates[N];
+static dt_t keys[K];
+static size_t idx[K];
+
+/* Compares dt_lower_bound_hint() with dt_lower_bound() from every hint for keys around the dates */
+static bool
+check_hint(size_t n) {
+    const dt_t *end, *hint, *exp, *got;
+    dt_t dt, lo, hi;
+
+    end = dates + n;
+    lo = n ? dates[0] - 2 : -2;
+    hi = n ? dates[n - 1] + 2 : 2;
+    for (dt = lo; dt <= hi; dt++) {
+        exp = dt_lower_bound(dt, dates, end);
+        for (hint = dates; hint <= end; hint++) {
+            got = dt_lower_bound_hint(dt, dates, end, hint);
+            if (got != exp) {
+                diag("n = %d, hint = %d: dt_lower_bound_hint(%d) = %d, exp %d",
+                     (int)n, (int)(hint - dates), dt, (int)(got - dates), (int)(exp - dates));
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+/* Compares dt_lower_bound_n() with dt_lower_bound() for each key */
+static bool
+check_n(size_t n, size_t k) {
+    const dt_t *end;
+    size_t i, exp;
+
+    end = dates + n;
+    dt_lower_bound_n(keys, k, dates, end, idx);
+    for (i = 0; i < k; i++) {
+        exp = (size_t)(dt_lower_bound(keys[i], dates, end) - dates);
+        if (idx[i] != exp) {
+            diag("n = %d: key %d (%d) = %d, exp %d", (int)n, (int)i, keys[i], (int)idx[i], (int)exp);
+            return false;
+        }
+    }
+    return true;
+}
+
+int
+main() {
+    unsigned int state;
+    size_t i, n;
+    bool good;
+
+    state = 1;
+    dates[0] = 735000;
+    for (i = 1; i < N; i++)
+        dates[i] = dates[i - 1] + (dt_t)((next_rand(&state) >> 8) % 3);
+
+    good = true;
+    for (n = 0; good && n <= 70; n++)
+        good = check_hint(n);
+    ok(good, "dt_lower_bound_hint() from every hint, sizes up to 70");
+
+    /* Sorted keys with repeats and gaps, spanning beyond both ends */
+    keys[0] = dates[0] - 5;
+    for (i = 1; i < K; i++)
+        keys[i] = keys[i - 1] + (dt_t)((next_rand(&state) >> 8) % 4);
+    good = true;
+    for (n = 0; good && n <= N; n += 37)
+        good = check_n(n, K);
+    ok(good, "dt_lower_bound_n() with sorted keys");
+
+    /* Sparse sorted keys, far apart in the dates */
+    for (i = 0; i < K; i++)
+        keys[i] = dates[0] + (dt_t)(i * 3);
+    ok(check_n(N, 300), "dt_lower_bound_n() with sparse sorted keys");
+
+    /* Unsorted keys */
+    for (i = 0; i < K; i++)
+        keys[i] = dates[0] - 10 + (dt_t)((next_rand(&state) >> 8) % (unsigned int)(dates[N - 1] - dates[0] + 20));
+    ok(check_n(N, K), "dt_lower_bound_n() with unsorted keys");
+
+    ok(check_n(0, K), "dt_lower_bound_n() with no dates");
+
+    done_testing();
+}
@@ -26,6 +26,8 @@ const struct good_t {
     {   1,  1,  1, "0001-01-01",                10 },
     {   1,  1,  1, "0001-001",                   8 },
     {9999, 12, 31, "9999-12-31",                10 },
+    {2000,  2, 29, "2000-02-29",                10 },
+    {2012,  2, 29, "2012-02-29T12:00:00Z",      10 },
 #ifdef DT_PARSE_ISO_YEAR0
     {   0,  1,  1, "0000-Q1-01",                10 },
     {   0,  1,  3, "0000-W01-1",                10 },
@@ -37,7 +39,7 @@ const struct good_t {
     {-1000,12, 31, "-1000-12-31",               11 },
     {-10000,12,31, "-10000-12-31",              12 },
     {-5879610,6,22,"-5879610-06-22",            14 },
-    {-5879610,12,27,"-5879610W521",             12 },
+    {-5879610,12,24,"-5879610W521",             12 },
     {10000, 1,  1, "10000-01-01",               11 },
     {5879611,7, 1, "5879611-07-01",             13 },
     {5879611,1, 1, "5879611Q101",               11 },
@@ -74,6 +76,15 @@ const struct bad_t {
     {"2012U1234"    },  /* Invalid */
     {"2012-1234"    },  /* Invalid */
     {"2012-X1234"   },  /* Invalid */
+    {"2100-02-29"   },  /* Invalid day of month */
+    {"2013-02-29"   },  /* Invalid day of month */
+    {"2012-04-31"   },  /* Invalid day of month */
+    {"2012-12-00"   },  /* Invalid day of month */
+    {"2012-00-24"   },  /* Invalid month */
+    {"2012-1a-24"   },  /* Invalid month */
+    {"2012-12-2:"   },  /* Invalid day of month */
+    {"2012/12/24"   },  /* Invalid separator */
+    {"2012-12-240"  },  /* Trailing digit */
 #ifndef DT_PARSE_ISO_YEAR0
     {"0000-Q1-01"   },  /* Year less than 0001 */
     {"0000-W01-1"   },  /* Year less than 0001 */
@@ -0,0 +1,95 @@
+#include <limits.h>
+#include "dt.h"
+#include "tap.h"
+#include <string.h>
+
+const struct good_t {
+    int ey;
+    int em;
+    int ed;
+    const char *str;
+    size_t elen;
+} good[] = {
+    {2012, 12, 24, "20121224",                   8 },
+    {2012, 12, 24, "2012-12-24T00:00:00+00:00", 10 },
+    {2012, 12, 24, "2012359",                    7 },
+    {2012, 12, 24, "2012-359",                   8 },
+    {2012, 12, 24, "2012W521",                   8 },
+    {2012, 12, 24, "2012-W52-1",                10 },
+#ifndef DT_PARSE_ISO_STRICT
+    {2012, 12, 24, "2012Q485",                   8 },
+    {2012, 12, 24, "2012-Q4-85",                10 },
+    {5879612, 1, 1, "+5879612-Q1-01",           14 },
+#endif
+    {2012, 12, 24, "+2012-12-24",               11 },
+    {   0,  1,  1, "+0000-01-01",               11 },
+    {  -1, 12, 31, "-0001-12-31",               11 },
+    {-10000,12,31, "-10000-12-31",              12 },
+    {-5879611,1,1, "-5879611-01-01",            14 },
+    {5879612, 1, 1, "+5879612-01-01",           14 },
+    {5879612, 1, 1, "+5879612-001",             12 },
+    {5879612, 1, 4, "+5879612-W01-3",           14 },
+    {999999999,12,31, "+999999999-12-31",       16 },
+    {-999999999,1,1, "-999999999-01-01",        16 },
+#ifdef DT_PARSE_ISO_YEAR0
+    {   0,  1,  1, "0000-01-01",                10 },
+#endif
+};
+
+const struct bad_t {
+    const char *str;
+} bad[] = {
+    {"20121232"          },  /* Invalid day of month */
+    {"2012-13-24"        },  /* Invalid month */
+    {"2012367"           },  /* Invalid day of year */
+    {"2012W533"          },  /* Invalid week of year */
+    {"2012-Q5-85"        },  /* Invalid quarter */
+    {"2012-12"           },  /* Reduced accuracy */
+    {"2012-W12"          },  /* Incomplete */
+    {"2012-W12-12"       },  /* Trailing digit */
+    {"+201-12-24"        },  /* Expanded year with less than 4 digits */
+    {"+1000000000-01-01" },  /* Expanded year with more than 9 digits */
+    {"+20121224"         },  /* Expanded year in basic format */
+    {"+2012W521"         },  /* Expanded year in basic format */
+    {"10000-01-01"       },  /* Unsigned year with more than 4 digits */
+    {"-5879611-02-29"    },  /* Invalid day of month */
+    {"+"                 },  /* Empty */
+    {""                  },  /* Empty */
+#ifndef DT_PARSE_ISO_YEAR0
+    {"0000-01-01"        },  /* Year less than 0001 */
+#endif
+};
+
+int
+main() {
+    int i, ntests;
+
+    ntests = sizeof(good) / sizeof(*good);
+    for (i = 0; i < ntests; i++) {
+        const struct good_t t = good[i];
+
+        {
+            dt64_t got = 0, exp = 0;
+            size_t glen;
+
+            glen = dt64_parse_iso_date(t.str, strlen(t.str), &got);
+            ok(glen == t.elen, "dt64_parse_iso_date(%s) size_t: %d", t.str, (int)glen);
+            exp = dt64_from_ymd(t.ey, t.em, t.ed);
+            ok(got == exp, "dt64_parse_iso_date(%s)", t.str);
+        }
+    }
+
+    ntests = sizeof(bad) / sizeof(*bad);
+    for (i = 0; i < ntests; i++) {
+        const struct bad_t t = bad[i];
+
+        {
+            dt64_t got = 0;
+            size_t glen;
+
+            glen = dt64_parse_iso_date(t.str, strlen(t.str), &got);
+            ok(glen == 0, "dt64_parse_iso_date(%s) size_t: %d", t.str, (int)glen);
+        }
+    }
+    done_testing();
+}
@@ -0,0 +1,130 @@
+#include <stdio.h>
+#include <string.h>
+#include "dt.h"
+#include "tap.h"
+#include "util.h"
+
+const struct good_t {
+    int ey;
+    int em;
+    int ed;
+    int esod;
+    int ensec;
+    int eoffset;
+    const char *str;
+    size_t elen;
+} good[] = {
+    {2012, 12, 24, 55845,         0,    0, "2012-12-24T15:30:45Z",                20 },
+    {2012, 12, 24, 55845,         0,    0, "2012-12-24t15:30:45z",                20 },
+    {2012, 12, 24, 55845,         0,    0, "2012-12-24 15:30:45Z",                20 },
+    {2012, 12, 24, 55845, 123456789,   60, "2012-12-24T15:30:45.123456789+01:00", 35 },
+    {2012, 12, 24, 55845, 123456789, -300, "2012-12-24T15:30:45.1234567891-05:00",36 },
+    {2012, 12, 24, 55845, 500000000, -330, "2012-12-24T15:30:45,5-05:30",         27 },
+    {2012, 12, 24, 55845,         0,    0, "2012-12-24T15:30:45",                 19 },
+    {2012, 12, 24, 55845,         0,    0, "2012-12-24T15:30:45 foo",             19 },
+    {2012, 12, 24, 55800,         0,   60, "2012-12-24T15:30+01",                 19 },
+    {2012, 12, 24, 55845,         0,   60, "20121224T153045+0100",                20 },
+    {2012, 12, 24, 55845,         0,   60, "2012-359T15:30:45+01:00",             23 },
+    {2012, 12, 24, 55845,         0,   60, "2012-W52-1T15:30:45+01:00",           25 },
+    {2012, 12, 24, 86400,         0,    0, "2012-12-24T24:00:00Z",                20 },
+    {2012, 12, 24,     0,         0,    0, "2012-12-24",                          10 },
+    {2012, 12, 24,     0,         0,    0, "2012-12-24 foo",                      10 },
+    {2012, 12, 24,     0,         0,    0, "2012-12-24 ",                         10 },
+    {2012, 12, 24, 55845,         0,    0, "2012-12-24T15:30:45+01:001",          19 },
+};
+
+const struct bad_t {
+    const char *str;
+} bad[] = {
+    {"2012-12-24T"              },  /* Missing time */
+    {"2012-12-24Tfoo"           },  /* Invalid time */
+    {"2012-12-24T25:00:00Z"     },  /* Invalid hour */
+    {"2012-12-24T15:60:00Z"     },  /* Invalid minute */
+    {"2012-12-24T15:30:60Z"     },  /* Invalid second */
+    {"2012-12-32T15:30:45Z"     },  /* Invalid day of month */
+    {"2012-12-24T15:30:45."     },  /* Missing fraction */
+};
+
+static bool
+compare_chain(const char *str, size_t len) {
+    size_t n, gn, r;
+    dt_t dt = 0, gdt = 0;
+    int sod = 0, nsec = 0, offset = 0, gsod = 0, gnsec = 0, goffset = 0;
+
+    n = dt_parse_iso_date(str, len, &dt);
+    if (n) {
+        r = dt_parse_iso_time(str + n + 1, len - n - 1, &sod, &nsec);
+        if (r) {
+            n += 1 + r;
+            n += dt_parse_iso_zone(str + n, len - n, &offset);
+        }
+        else
+            n = 0;
+    }
+    if (!n)
+        dt = sod = nsec = offset = 0;
+
+    gn = dt_parse_iso_datetime(str, len, &gdt, &gsod, &gnsec, &goffset);
+    if (gn == n && gdt == dt && gsod == sod && gnsec == nsec && goffset == offset)
+        return true;
+    diag("    str: %s", str);
+    diag("    got: %d %d %d %d (%d)", gdt, gsod, gnsec, goffset, (int)gn);
+    diag("    exp: %d %d %d %d (%d)", dt, sod, nsec, offset, (int)n);
+    return false;
+}
+
+int
+main() {
+    int i, ntests;
+
+    ntests = sizeof(good) / sizeof(*good);
+    for (i = 0; i < ntests; i++) {
+        const struct good_t t = good[i];
+        dt_t dt = 0;
+        int sod = -1, nsec = -1, offset = -1;
+        size_t glen;
+
+        glen = dt_parse_iso_datetime(t.str, strlen(t.str), &dt, &sod, &nsec, &offset);
+        ok(glen == t.elen, "dt_parse_iso_datetime(%s) size_t: %d", t.str, (int)glen);
+        ok(dt == dt_from_ymd(t.ey, t.em, t.ed) && sod == t.esod &&
+           nsec == t.ensec && offset == t.eoffset,
+           "dt_parse_iso_datetime(%s)", t.str);
+    }
+
+    ntests = sizeof(bad) / sizeof(*bad);
+    for (i = 0; i < ntests; i++) {
+        const struct bad_t t = bad[i];
+        size_t glen;
+
+        glen = dt_parse_iso_datetime(t.str, strlen(t.str), NULL, NULL, NULL, NULL);
+        ok(glen == 0, "dt_parse_iso_datetime(%s) size_t: %d", t.str, (int)glen);
+    }
+
+    {
+        static const char *zones[] = { "Z", "+01:00", "-05:30", "+23:59", "-00:00", "+24:00" };
+        static const char *fractions[] = { "", ".5", ".123", ",123456", ".123456789", ".1234567890" };
+        unsigned int state = 1, r;
+        char buf[64];
+        bool good = true;
+
+        for (i = 0; good && i < 100000; i++) {
+            int y, m, d, h, mi, s;
+
+            r  = next_rand(&state);
+            y  = 1 + (r >> 8) % 9999;
+            m  = 1 + (r >> 4) % 12;
+            r  = next_rand(&state);
+            d  = 1 + (r >> 8) % 31;
+            h  = (r >> 3) % 25;
+            r  = next_rand(&state);
+            mi = (r >> 8) % 61;
+            s  = (r >> 4) % 61;
+            snprintf(buf, sizeof(buf), "%04d-%02d-%02dT%02d:%02d:%02d%s%s",
+                     y, m, d, h, mi, s, fractions[(r >> 16) % 6], zones[(r >> 20) % 6]);
+            good = compare_chain(buf, strlen(buf));
+        }
+        ok(good, "dt_parse_iso_datetime() equals dt_parse_iso_date/time/zone()");
+    }
+
+    done_testing();
+}
@@ -0,0 +1,152 @@
+#include "dt.h"
+#include "tap.h"
+#include <string.h>
+
+const struct good_t {
+    const char *pattern;
+    const char *str;
+    size_t elen;
+    int y, m, d;
+    int sod;
+    int nsec;
+    int offset;
+} good[] = {
+    { "%Y-%m-%d",               "2012-12-24",                   10, 2012, 12, 24,     0,         0,    0 },
+    { "%F",                     "2012-12-24",                   10, 2012, 12, 24,     0,         0,    0 },
+    { "%Y%m%d",                 "20121224",                      8, 2012, 12, 24,     0,         0,    0 },
+    { "%Y%m%d",                 "20121224T",                     8, 2012, 12, 24,     0,         0,    0 },
+    { "%d/%m/%Y",               "1/2/2012",                      8, 2012,  2,  1,     0,         0,    0 },
+    { "%D",                     "12/24/12",                      8, 2012, 12, 24,     0,         0,    0 },
+    { "%D",                     "12/24/69",                      8, 1969, 12, 24,     0,         0,    0 },
+    { "%D",                     "12/24/68",                      8, 2068, 12, 24,     0,         0,    0 },
+    { "%Y-%j",                  "2012-366",                      8, 2012, 12, 31,     0,         0,    0 },
+    { "%Y-%j",                  "2013-060",                      8, 2013,  3,  1,     0,         0,    0 },
+    { "%Y",                     "2012",                          4, 2012,  1,  1,     0,         0,    0 },
+    { "%H:%M",                  "12:30",                         5, 1970,  1,  1, 45000,         0,    0 },
+    { "%T",                     "23:59:59",                      8, 1970,  1,  1, 86399,         0,    0 },
+    { "%F %T",                  "2012-12-24 12:30:45",          19, 2012, 12, 24, 45045,         0,    0 },
+    { "%F %T",                  "2012-12-24  \t12:30:45",       21, 2012, 12, 24, 45045,         0,    0 },
+    { "%F %T",                  "2012-12-2412:30:45",           18, 2012, 12, 24, 45045,         0,    0 },
+    { "%F%t%T",                 "2012-12-24\t12:30:45",         19, 2012, 12, 24, 45045,         0,    0 },
+    { "%T.%f",                  "12:30:45.5",                   10, 1970,  1,  1, 45045, 500000000,    0 },
+    { "%T.%f",                  "12:30:45.123456789",           18, 1970,  1,  1, 45045, 123456789,    0 },
+    { "%T.%f",                  "12:30:45.1234567891",          19, 1970,  1,  1, 45045, 123456789,    0 },
+    { "%FT%T%z",                "2012-12-24T12:30:45+01:00",    25, 2012, 12, 24, 45045,         0,   60 },
+    { "%FT%T%z",                "2012-12-24T12:30:45-0530",     24, 2012, 12, 24, 45045,         0, -330 },
+    { "%FT%T%z",                "2012-12-24T12:30:45Z",         20, 2012, 12, 24, 45045,         0,    0 },
+    { "%F %T %Z",               "2012-12-24 12:30:45 EST",      23, 2012, 12, 24, 45045,         0, -300 },
+    { "%F %T %Z",               "2012-12-24 12:30:45 cest",     24, 2012, 12, 24, 45045,         0,  120 },
+    { "%d %b %Y",               "24 Dec 2012",                  11, 2012, 12, 24,     0,         0,    0 },
+    { "%d %B %Y",               "24 december 2012",             16, 2012, 12, 24,     0,         0,    0 },
+    { "%e %h %Y",               " 4 SEP 2012",                  11, 2012,  9,  4,     0,         0,    0 },
+    { "%a, %d %b %Y %T %Z",     "Mon, 24 Dec 2012 12:30:45 GMT", 29, 2012, 12, 24, 45045,       0,    0 },
+    { "%d/%b/%Y:%T %z",         "24/Dec/2012:12:30:45 +0100",   26, 2012, 12, 24, 45045,         0,   60 },
+    { "%A %F",                  "Monday 2012-12-24",            17, 2012, 12, 24,     0,         0,    0 },
+    { "%u %F",                  "1 2012-12-24",                 12, 2012, 12, 24,     0,         0,    0 },
+    { "%I:%M %p",               "12:30 am",                      8, 1970,  1,  1,  1800,         0,    0 },
+    { "%I:%M %p",               "12:30 PM",                      8, 1970,  1,  1, 45000,         0,    0 },
+    { "%I:%M %p",               "01:30 pm",                      8, 1970,  1,  1, 48600,         0,    0 },
+    { "%I:%M",                  "11:30",                         5, 1970,  1,  1, 41400,         0,    0 },
+    { "%Y-%m-%d 100%%",         "2012-12-24 100%",              15, 2012, 12, 24,     0,         0,    0 },
+    { "%F",                     "2012-2-9",                      8, 2012,  2,  9,     0,         0,    0 },
+    { "",                       "2012",                          0, 1970,  1,  1,     0,         0,    0 },
+};
+
+const struct bad_t {
+    const char *pattern;
+    const char *str;
+} bad[] = {
+    { "%F",                     ""                              },
+    { "%F",                     "2012-12"                       },
+    { "%F",                     "2012-13-01"                    },
+    { "%F",                     "2012-02-30"                    },
+    { "%F",                     "2013-02-29"                    },
+    { "%F",                     "2012/12/24"                    },
+    { "%F",                     "2012-00-24"                    },
+    { "%Y-%j",                  "2013-366"                      },
+    { "%Y-%j",                  "2013-000"                      },
+    { "%T",                     "24:00:00"                      },
+    { "%T",                     "12:60:00"                      },
+    { "%T",                     "12:30:60"                      },
+    { "%T.%f",                  "12:30:45."                     },
+    { "%I:%M",                  "00:30"                         },
+    { "%I:%M",                  "13:30"                         },
+    { "%I:%M %p",               "12:30 xm"                      },
+    { "%I:%M %p",               "12:30 a"                       },
+    { "%d %b %Y",               "24 De 2012"                    },
+    { "%d %b %Y",               "24 Decem 2012"                 },
+    { "%d %b %Y",               "24 Dex 2012"                   },
+    { "%A %F",                  "Tuesday 2012-12-24"            },
+    { "%a %F",                  "Tue 2012-12-24"                },
+    { "%u %F",                  "2 2012-12-24"                  },
+    { "%u %F",                  "0 2012-12-24"                  },
+    { "%FT%T%z",                "2012-12-24T12:30:45"           },
+    { "%F %T %Z",               "2012-12-24 12:30:45 IST"       },
+    { "%F %T %Z",               "2012-12-24 12:30:45 XYZ"       },
+    { "%Y-%m-%d 100%%",         "2012-12-24 100"                },
+};
+
+const char *bad_patterns[] = {
+    "%Q",
+    "%",
+    "%Y %Y",
+    "%Y %y",
+    "%m %b",
+    "%z %Z",
+    "%H %I",
+    "%j %m",
+    "%j %d",
+    "%p",
+    "%H %p",
+    "%F %T %F",
+    "%Y-%m-%d %H:%M:%S ........................................................",
+    "xxxxxxxxxxxxxxxxxxxxxxxxxxxxxxx%Y ",
+};
+
+int
+main() {
+    dt_parse_pattern_t pat;
+    int i, ntests;
+
+    ntests = sizeof(good) / sizeof(*good);
+    for (i = 0; i < ntests; i++) {
+        const struct good_t t = good[i];
+
+        {
+            dt_t got, exp;
+            int sod, nsec, offset;
+            size_t glen;
+
+            if (!ok(dt_parse_pattern_compile(&pat, t.pattern), "dt_parse_pattern_compile(%s)", t.pattern))
+                continue;
+            sod = nsec = offset = -1;
+            glen = dt_parse_pattern(&pat, t.str, strlen(t.str), &got, &sod, &nsec, &offset);
+            ok(glen == t.elen, "dt_parse_pattern(%s, %s) size_t: %d", t.pattern, t.str, (int)glen);
+            exp = dt_from_ymd(t.y, t.m, t.d);
+            cmp_ok(got, "==", exp, "dt_parse_pattern(%s, %s) dt", t.pattern, t.str);
+            cmp_ok(sod, "==", t.sod, "dt_parse_pattern(%s, %s) sod", t.pattern, t.str);
+            cmp_ok(nsec, "==", t.nsec, "dt_parse_pattern(%s, %s) nsec", t.pattern, t.str);
+            cmp_ok(offset, "==", t.offset, "dt_parse_pattern(%s, %s) offset", t.pattern, t.str);
+        }
+    }
+
+    ntests = sizeof(bad) / sizeof(*bad);
+    for (i = 0; i < ntests; i++) {
+        const struct bad_t t = bad[i];
+
+        {
+            size_t glen;
+
+            if (!ok(dt_parse_pattern_compile(&pat, t.pattern), "dt_parse_pattern_compile(%s)", t.pattern))
+                continue;
+            glen = dt_parse_pattern(&pat, t.str, strlen(t.str), NULL, NULL, NULL, NULL);
+            ok(glen == 0, "dt_parse_pattern(%s, %s) size_t: %d", t.pattern, t.str, (int)glen);
+        }
+    }
+
+    ntests = sizeof(bad_patterns) / sizeof(*bad_patterns);
+    for (i = 0; i < ntests; i++) {
+        ok(!dt_parse_pattern_compile(&pat, bad_patterns[i]), "!dt_parse_pattern_compile(%s)", bad_patterns[i]);
+    }
+    done_testing();
+}
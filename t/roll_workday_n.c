@@ -0,0 +1,104 @@
+#include <stdlib.h>
+#include "dt.h"
+#include "tap.h"
+#include "util.h"
+
+#define N 2000
+
+static dt_t src[N], dst[N];
+static dt_t holidays[N];
+
+static int
+compare_dt(const void *a, const void *b) {
+    const dt_t x = *(const dt_t *)a;
+    const dt_t y = *(const dt_t *)b;
+    return (x > y) - (x < y);
+}
+
+/* Sorted, unique weekdays, about one in every dense days */
+static size_t
+fill_holidays(dt_t first, dt_t last, unsigned int dense, unsigned int *state) {
+    size_t n;
+    dt_t dt;
+
+    n = 0;
+    for (dt = first; dt <= last && n < N; dt++) {
+        if (dt_is_weekday(dt) && (next_rand(state) >> 8) % dense == 0)
+            holidays[n++] = dt;
+    }
+    return n;
+}
+
+static const dt_bdc_t conventions[] = {
+    DT_UNADJUSTED,
+    DT_FOLLOWING,
+    DT_MODIFIED_FOLLOWING,
+    DT_PRECEDING,
+    DT_MODIFIED_PRECEDING,
+};
+
+static const char *names[] = {
+    "unadjusted",
+    "following",
+    "modified following",
+    "preceding",
+    "modified preceding",
+};
+
+static bool
+compare(size_t n, const dt_t *holidays, size_t nholidays, const char *order) {
+    size_t c, i;
+    dt_t exp;
+
+    for (c = 0; c < 5; c++) {
+        dt_roll_workday_n(src, n, conventions[c], holidays, nholidays, dst);
+        for (i = 0; i < n; i++) {
+            exp = dt_roll_workday(src[i], conventions[c], holidays, nholidays);
+            if (dst[i] != exp) {
+                diag("%s, %s, %d holidays: dt %d got %d exp %d",
+                     order, names[c], (int)nholidays, src[i], dst[i], exp);
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+int
+main() {
+    static const unsigned int densities[] = { 1000000, 40, 3, 1 };
+    unsigned int state;
+    size_t d, i, n, nholidays;
+    dt_t first, t;
+
+    state = 1;
+    first = dt_from_ymd(2010, 1, 1);
+    for (d = 0; d < sizeof(densities) / sizeof(*densities); d++) {
+        nholidays = fill_holidays(first - 400, first + 2400, densities[d], &state);
+
+        /* A schedule, every few days in ascending order */
+        for (i = 0, n = 0; i < N; i++, n++)
+            src[i] = first + (dt_t)(i * 3 / 2);
+        ok(compare(n, holidays, nholidays, "ascending"),
+           "dt_roll_workday_n() ascending, %d holidays", (int)nholidays);
+
+        for (i = 0; i < n / 2; i++) {
+            t = src[i];
+            src[i] = src[n - 1 - i];
+            src[n - 1 - i] = t;
+        }
+        ok(compare(n, holidays, nholidays, "descending"),
+           "dt_roll_workday_n() descending, %d holidays", (int)nholidays);
+
+        for (i = 0; i < n; i++)
+            src[i] = first - 300 + (dt_t)((next_rand(&state) >> 8) % 2400);
+        ok(compare(n, holidays, nholidays, "random"),
+           "dt_roll_workday_n() random, %d holidays", (int)nholidays);
+
+        qsort(src, n, sizeof(dt_t), compare_dt);
+        ok(compare(n, holidays, nholidays, "sorted"),
+           "dt_roll_workday_n() sorted with repeats, %d holidays", (int)nholidays);
+    }
+    ok(compare(0, holidays, 0, "empty"), "dt_roll_workday_n() no dates");
+    done_testing();
+}
@@ -0,0 +1,59 @@
+#include "dt.h"
+#include "tap.h"
+#include "util.h"
+
+#define N 5000
+
+static dt_t dates[N];
+
+/* Compares the index with dt_lower_bound() and friends for every key around the dates */
+static bool
+check(size_t n) {
+    dt_search_index_t *idx;
+    const dt_t *end;
+    dt_t dt, lo, hi;
+    bool good;
+
+    idx = dt_search_index_new(dates, dates + n);
+    if (!idx)
+        return false;
+    end = dates + n;
+    lo = n ? dates[0] - 3 : -3;
+    hi = n ? dates[n - 1] + 3 : 3;
+    good = true;
+    for (dt = lo; good && dt <= hi; dt++) {
+        good = dt_search_index_lower_bound(idx, dt) == (size_t)(dt_lower_bound(dt, dates, end) - dates)
+            && dt_search_index_upper_bound(idx, dt) == (size_t)(dt_upper_bound(dt, dates, end) - dates)
+            && dt_search_index_contains(idx, dt) == dt_binary_search(dt, dates, end);
+        if (!good)
+            diag("n = %d, dt = %d", (int)n, dt);
+    }
+    dt_search_index_free(idx);
+    return good;
+}
+
+int
+main() {
+    unsigned int state;
+    size_t i, n;
+    bool good;
+
+    state = 1;
+    dates[0] = 730000;
+    for (i = 1; i < N; i++)
+        dates[i] = dates[i - 1] + (dt_t)((next_rand(&state) >> 8) % 4);
+
+    good = true;
+    for (n = 0; good && n <= 300; n++)
+        good = check(n);
+    ok(good, "every size up to 300, with repeated dates");
+    ok(check(1023) && check(1024) && check(1025), "sizes around a power of two");
+    ok(check(N), "%d dates", N);
+
+    for (i = 0; i < N; i++)
+        dates[i] = 730000 + 7 * (dt_t)i;
+    ok(check(N), "%d unique dates", N);
+
+    dt_search_index_free(NULL);
+    done_testing();
+}
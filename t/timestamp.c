@@ -0,0 +1,103 @@
+#include <limits.h>
+#include "dt.h"
+#include "tap.h"
+#include "util.h"
+
+static bool
+is_ts(dt_timestamp_t ts, int64_t sec, int32_t nsec) {
+    if (ts.sec == sec && ts.nsec == nsec)
+        return true;
+    diag("    got: %lld.%09d", (long long)ts.sec, ts.nsec);
+    diag("    exp: %lld.%09d", (long long)sec, nsec);
+    return false;
+}
+
+int
+main() {
+    unsigned int state;
+    dt_timestamp_t ts;
+    int i;
+    bool good;
+
+    ok(is_ts(dt_timestamp_from_dt(dt_from_ymd(1970, 1, 1), 0, 0), 0, 0),
+       "dt_timestamp_from_dt(1970-01-01T00:00:00)");
+    ok(is_ts(dt_timestamp_from_dt(dt_from_ymd(2000, 1, 1), 3661, 5), 946688461, 5),
+       "dt_timestamp_from_dt(2000-01-01T01:01:01.000000005)");
+    ok(is_ts(dt_timestamp_from_dt(dt_from_ymd(1969, 12, 31), 86399, 999999999), -1, 999999999),
+       "dt_timestamp_from_dt(1969-12-31T23:59:59.999999999)");
+    ok(is_ts(dt_timestamp_from_dt64(dt64_from_ymd(INT_MAX, 12, 31), 0, 0),
+             (dt64_from_ymd(INT_MAX, 12, 31) - DT_TIMESTAMP_EPOCH) * 86400, 0),
+       "dt_timestamp_from_dt64(INT_MAX-12-31)");
+
+    {
+        dt_t dt, gdt;
+        int sod, nsec, gsod, gnsec;
+
+        state = 1;
+        good = true;
+        for (i = 0; good && i < 1000000; i++) {
+            dt   = (dt_t)next_rand(&state);
+            sod  = (int)(next_rand(&state) % 86400);
+            nsec = (int)(next_rand(&state) % 1000000000);
+            ts = dt_timestamp_from_dt(dt, sod, nsec);
+            dt_timestamp_to_dt(ts, &gdt, &gsod, &gnsec);
+            if (gdt != dt || gsod != sod || gnsec != nsec) {
+                diag("    dt: %d sod: %d nsec: %d", dt, sod, nsec);
+                good = false;
+            }
+        }
+        ok(good, "dt_timestamp_to_dt(dt_timestamp_from_dt()) round-trips");
+    }
+
+    {
+        dt64_t dt;
+        int sod, nsec;
+
+        ts.sec = -1;
+        ts.nsec = 0;
+        dt_timestamp_to_dt64(ts, &dt, &sod, &nsec);
+        ok(dt == dt64_from_ymd(1969, 12, 31) && sod == 86399 && nsec == 0,
+           "dt_timestamp_to_dt64(-1)");
+        ts.sec = -86400;
+        dt_timestamp_to_dt64(ts, &dt, &sod, NULL);
+        ok(dt == dt64_from_ymd(1969, 12, 31) && sod == 0,
+           "dt_timestamp_to_dt64(-86400)");
+    }
+
+    ok(is_ts(dt_timestamp_normalize(10, 2500000000LL), 12, 500000000),
+       "dt_timestamp_normalize(10, 2.5e9)");
+    ok(is_ts(dt_timestamp_normalize(10, -1), 9, 999999999),
+       "dt_timestamp_normalize(10, -1)");
+    ok(is_ts(dt_timestamp_normalize(0, -2000000000LL), -2, 0),
+       "dt_timestamp_normalize(0, -2e9)");
+
+    ts.sec = 100;
+    ts.nsec = 900000000;
+    ok(is_ts(dt_timestamp_add(ts, 1, 200000000), 102, 100000000), "dt_timestamp_add() carry");
+    ok(is_ts(dt_timestamp_add(ts, -1, -950000000), 98, 950000000), "dt_timestamp_add() borrow");
+    ok(is_ts(dt_timestamp_add(ts, 0, 99999999), 100, 999999999), "dt_timestamp_add()");
+    ok(is_ts(dt_timestamp_sub(ts, 200, 900000001), -101, 999999999), "dt_timestamp_sub()");
+    ok(is_ts(dt_timestamp_add_nsec(ts, -1900000001LL), 98, 999999999), "dt_timestamp_add_nsec()");
+    ok(is_ts(dt_timestamp_add_nsec(ts, 3100000000LL), 104, 0), "dt_timestamp_add_nsec()");
+
+    {
+        dt_timestamp_t a, b;
+        int64_t sec;
+        int32_t nsec;
+
+        state = 2;
+        good = true;
+        for (i = 0; good && i < 100000; i++) {
+            a = dt_timestamp_normalize((int32_t)next_rand(&state), next_rand(&state));
+            b = dt_timestamp_normalize((int32_t)next_rand(&state), next_rand(&state));
+            dt_timestamp_delta(a, b, &sec, &nsec);
+            good = nsec >= 0 && nsec < 1000000000 &&
+                   is_ts(dt_timestamp_add(a, sec, nsec), b.sec, b.nsec) &&
+                   dt_timestamp_compare(b, a) == (sec > 0 || (sec == 0 && nsec > 0)) - (sec < 0) &&
+                   dt_timestamp_compare(b, a) == -dt_timestamp_compare(a, b);
+        }
+        ok(good, "dt_timestamp_delta()/dt_timestamp_compare()");
+    }
+
+    done_testing();
+}
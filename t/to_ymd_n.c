@@ -0,0 +1,124 @@
+#include "dt.h"
+#include "tap.h"
+#include "util.h"
+
+#define N 4096
+
+/*
+ * dt_to_ymd() overflows for dates close to the limits of dt_t, compare
+ * against it only within +/- 5 million years.
+ */
+#define YEAR_MAX 5000000
+
+static dt_t src[N];
+static int ys[N], ms[N], ds[N];
+
+static bool
+compare(size_t n, bool wide) {
+    size_t i;
+    int y, m, d;
+
+    for (i = 0; i < n; i++) {
+        if (wide)
+            dt64_to_ymd(dt64_from_dt(src[i]), &y, &m, &d);
+        else
+            dt_to_ymd(src[i], &y, &m, &d);
+        if (ys[i] != y || ms[i] != m || ds[i] != d) {
+            diag("     dt: %d", src[i]);
+            diag("    got: %.4d-%.2d-%.2d", ys[i], ms[i], ds[i]);
+            diag("    exp: %.4d-%.2d-%.2d", y, m, d);
+            return false;
+        }
+    }
+    return true;
+}
+
+int
+main() {
+    unsigned int state, span;
+    size_t i, n;
+    dt_t first, lo, hi;
+    bool good;
+
+    lo = dt_from_ymd(-YEAR_MAX, 1, 1);
+    hi = dt_from_ymd(YEAR_MAX, 12, 31);
+    span = (unsigned int)hi - (unsigned int)lo + 1;
+
+    {
+        first = dt_from_ymd(1600, 1, 1);
+        good = true;
+        while (good && first < dt_from_ymd(2400, 12, 31)) {
+            for (i = 0; i < N; i++)
+                src[i] = first + (dt_t)i;
+            dt_to_ymd_n(src, N, ys, ms, ds);
+            good = compare(N, false);
+            first += N;
+        }
+        ok(good, "dt_to_ymd_n(1600-01-01 .. 2400-12-31)");
+    }
+
+    {
+        first = dt_from_ymd(-2400, 1, 1);
+        good = true;
+        while (good && first < dt_from_ymd(-1600, 12, 31)) {
+            for (i = 0; i < N; i++)
+                src[i] = first + (dt_t)i;
+            dt_to_ymd_n(src, N, ys, ms, ds);
+            good = compare(N, false);
+            first += N;
+        }
+        ok(good, "dt_to_ymd_n(-2400-01-01 .. -1600-12-31)");
+    }
+
+    {
+        state = 1;
+        good = true;
+        for (n = 0; good && n < 1000; n++) {
+            for (i = 0; i < N; i++)
+                src[i] = (dt_t)((unsigned int)lo + next_rand(&state) % span);
+            dt_to_ymd_n(src, N, ys, ms, ds);
+            good = compare(N, false);
+        }
+        ok(good, "dt_to_ymd_n(random dates)");
+    }
+
+    {
+        const dt_t edges[] = {
+            lo, lo + 1, hi - 1, hi, -1, 0, 1, 2,
+            -536761000, -536760684, -536760683, -536760682,
+             536981139,  536981140,  536981141,  536981142,
+        };
+        for (i = 0; i < sizeof(edges) / sizeof(*edges); i++)
+            src[i] = edges[i];
+        dt_to_ymd_n(src, i, ys, ms, ds);
+        ok(compare(i, false), "dt_to_ymd_n(edge dates)");
+        ok(compare(i, true), "dt_to_ymd_n(edge dates) agrees with dt64_to_ymd()");
+    }
+
+    {
+        good = true;
+        for (n = 0; good && n < 20; n++) {
+            for (i = 0; i < N; i++) {
+                src[i] = dt_from_ymd(2012, 12, 24) + (dt_t)i;
+                ys[i] = ms[i] = ds[i] = -1;
+            }
+            dt_to_ymd_n(src, n, ys, ms, ds);
+            good = compare(n, false) && ys[n] == -1 && ms[n] == -1 && ds[n] == -1;
+        }
+        ok(good, "dt_to_ymd_n() respects the length for n < 20");
+    }
+
+    {
+        for (i = 0; i < 16; i++) {
+            src[i] = dt_from_ymd(2012, 12, 24) + (dt_t)i;
+            ys[i] = ms[i] = ds[i] = -1;
+        }
+        dt_to_ymd_n(src, 16, NULL, ms, NULL);
+        good = ys[0] == -1 && ds[0] == -1;
+        for (i = 0; i < 16; i++)
+            good = good && ms[i] == dt_month(src[i]);
+        ok(good, "dt_to_ymd_n() with NULL outputs");
+    }
+
+    done_testing();
+}
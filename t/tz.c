@@ -0,0 +1,149 @@
+#include <stdio.h>
+#include <string.h>
+#include "dt.h"
+#include "tap.h"
+#include "util.h"
+
+static unsigned char buf[8192];
+
+static int64_t
+instant(int y, int m, int d, int h, int min) {
+    return dt_timestamp_from_dt(dt_from_ymd(y, m, d), h * 3600 + min * 60, 0).sec;
+}
+
+/* The offset of New York from 2007 on */
+static int32_t
+new_york_offset(int64_t utc) {
+    dt_timestamp_t ts;
+    dt_t dt;
+    int y;
+
+    ts.sec = utc;
+    ts.nsec = 0;
+    dt_timestamp_to_dt(ts, &dt, NULL, NULL);
+    y = dt_year(dt);
+    if (utc >= dt_timestamp_from_dt(dt_nth_dow_in_month(dt_from_ymd(y, 3, 1), 2, DT_SUNDAY), 7 * 3600, 0).sec
+     && utc < dt_timestamp_from_dt(dt_nth_dow_in_month(dt_from_ymd(y, 11, 1), 1, DT_SUNDAY), 6 * 3600, 0).sec)
+        return -4 * 3600;
+    return -5 * 3600;
+}
+
+static void
+check_new_york(dt_tz_t *tz, const char *name) {
+    dt_tz_interval_t cache, iv;
+    int64_t utc, local, back;
+    bool good;
+    int hits;
+
+    /* Every half hour for 40 years, through the transitions of the rule */
+    memset(&cache, 0, sizeof(cache));
+    good = true;
+    hits = 0;
+    for (utc = instant(2019, 1, 1, 0, 0); good && utc < instant(2059, 1, 1, 0, 0); utc += 1800) {
+        local = dt_tz_utc_to_local(tz, utc, &cache);
+        if (local - utc != new_york_offset(utc)) {
+            diag("%s: offset at %lld is %d", name, (long long)utc, (int)(local - utc));
+            good = false;
+        }
+        back = dt_tz_local_to_utc(tz, local, DT_TZ_EARLIER, &cache);
+        if (back != utc)
+            back = dt_tz_local_to_utc(tz, local, DT_TZ_LATER, &cache);
+        if (back != utc) {
+            diag("%s: %lld converts back to %lld", name, (long long)utc, (long long)back);
+            good = false;
+        }
+        hits += cache.start <= utc && utc < cache.end;
+    }
+    ok(good, "%s: UTC to local and back, 2019 through 2058", name);
+
+    /* 2020-03-08 02:30 does not exist, 2020-11-01 01:30 occurs twice */
+    local = instant(2020, 3, 8, 2, 30);
+    cmp_ok((int)(dt_tz_local_to_utc(tz, local, DT_TZ_EARLIER, NULL) - instant(2020, 3, 8, 6, 30)), "==", 0,
+           "%s: skipped local time, earlier", name);
+    cmp_ok((int)(dt_tz_local_to_utc(tz, local, DT_TZ_LATER, NULL) - instant(2020, 3, 8, 7, 30)), "==", 0,
+           "%s: skipped local time, later", name);
+    local = instant(2020, 11, 1, 1, 30);
+    cmp_ok((int)(dt_tz_local_to_utc(tz, local, DT_TZ_EARLIER, NULL) - instant(2020, 11, 1, 5, 30)), "==", 0,
+           "%s: repeated local time, earlier", name);
+    cmp_ok((int)(dt_tz_local_to_utc(tz, local, DT_TZ_LATER, NULL) - instant(2020, 11, 1, 6, 30)), "==", 0,
+           "%s: repeated local time, later", name);
+
+    dt_tz_interval(tz, instant(2021, 7, 4, 12, 0), &iv);
+    ok(iv.start == instant(2021, 3, 14, 7, 0) && iv.end == instant(2021, 11, 7, 6, 0),
+       "%s: summer 2021 interval", name);
+    ok(iv.local_start == instant(2021, 3, 14, 3, 0) && iv.local_end == instant(2021, 11, 7, 1, 0),
+       "%s: unambiguous local times of summer 2021", name);
+    ok(iv.dst && iv.offset == -4 * 3600 && strcmp(iv.abbr, "EDT") == 0, "%s: EDT", name);
+}
+
+int
+main() {
+    static const tzif_type_t types[] = {
+        { -5 * 3600, 0, 0 },
+        { -4 * 3600, 1, 4 },
+    };
+    static const unsigned char idx[] = { 1, 0, 1, 0 };
+    int64_t times[4];
+    dt_tz_interval_t iv;
+    dt_tz_t *tz;
+    size_t len;
+
+    times[0] = instant(2019, 3, 10, 7, 0);
+    times[1] = instant(2019, 11, 3, 6, 0);
+    times[2] = instant(2020, 3, 8, 7, 0);
+    times[3] = instant(2020, 11, 1, 6, 0);
+
+    /* Transitions through 2020 and the rule after */
+    len = tzif_build(buf, times, idx, 4, types, 2, "EST\0EDT", 8, "EST5EDT,M3.2.0,M11.1.0");
+    tz = dt_tz_parse(buf, len);
+    ok(tz != NULL, "dt_tz_parse() with transitions and a rule");
+    if (tz)
+        check_new_york(tz, "transitions");
+    dt_tz_free(tz);
+
+    /* The rule alone, as in a file written with zic -b slim */
+    len = tzif_build(buf, times, idx, 0, types, 1, "EST", 4, "EST5EDT,M3.2.0,M11.1.0");
+    tz = dt_tz_parse(buf, len);
+    ok(tz != NULL, "dt_tz_parse() with a rule only");
+    if (tz)
+        check_new_york(tz, "rule");
+    dt_tz_free(tz);
+
+    /* A southern zone with a half hour change, daylight saving time spans the new year */
+    len = tzif_build(buf, times, idx, 0, types, 1, "EST", 4, "<+1030>-10:30<+11>-11,M10.1.0,M4.1.0");
+    tz = dt_tz_parse(buf, len);
+    ok(tz != NULL, "dt_tz_parse() with a southern rule");
+    if (tz) {
+        dt_tz_interval(tz, instant(2031, 1, 15, 0, 0), &iv);
+        ok(iv.offset == 11 * 3600 && iv.dst && strcmp(iv.abbr, "+11") == 0, "southern summer");
+        ok(iv.start == instant(2030, 10, 6, 2, 0) - 10 * 3600 - 1800, "starts on 2030-10-06 02:00 local");
+        ok(iv.end == instant(2031, 4, 6, 2, 0) - 11 * 3600, "ends on 2031-04-06 02:00 local");
+        dt_tz_interval(tz, instant(2031, 7, 15, 0, 0), &iv);
+        ok(iv.offset == 10 * 3600 + 1800 && !iv.dst && strcmp(iv.abbr, "+1030") == 0, "southern winter");
+    }
+    dt_tz_free(tz);
+
+    /* A fixed offset */
+    len = tzif_build(buf, times, idx, 0, types, 1, "EST", 4, "EST5");
+    tz = dt_tz_parse(buf, len);
+    ok(tz && dt_tz_utc_to_local(tz, 0, NULL) == -5 * 3600, "fixed offset");
+    dt_tz_free(tz);
+
+    len = tzif_build(buf, times, idx, 4, types, 2, "EST\0EDT", 8, "EST5EDT,M3.2.0,M11.1.0");
+    ok(dt_tz_parse(buf, len - 5) == NULL, "truncated footer");
+    ok(dt_tz_parse(buf, 100) == NULL, "truncated data");
+    buf[3] = 'F';
+    ok(dt_tz_parse(buf, len) == NULL, "bad magic");
+    len = tzif_build(buf, times, idx, 4, types, 2, "EST\0EDT", 8, "EST5EDT,M13.2.0,M11.1.0");
+    ok(dt_tz_parse(buf, len) == NULL, "bad rule");
+
+    ok(dt_tz_load("../../etc/passwd") == NULL, "names outside the zoneinfo directory");
+
+    tz = dt_tz_load("America/New_York");
+    skip(tz == NULL, 7, "no " DT_TZ_DIR "/America/New_York");
+        check_new_york(tz, "America/New_York");
+    endskip;
+    dt_tz_free(tz);
+
+    done_testing();
+}
@@ -0,0 +1,98 @@
+#include <string.h>
+#include "dt.h"
+#include "tap.h"
+#include "util.h"
+
+#define N 5000
+
+static unsigned char buf[256];
+static int64_t src[N];
+static dt_t dts[N];
+static int sods[N];
+
+/* A file with one type and no transitions, for the rule in footer */
+static size_t
+build(const char *footer) {
+    static const tzif_type_t type = { 0, 0, 0 };
+
+    return tzif_build(buf, NULL, NULL, 0, &type, 1, "", 1, footer);
+}
+
+/* Compares dt_tz_utc_to_local_n() with dt_tz_utc_to_local() row by row */
+static bool
+check(const dt_tz_t *tz, size_t n, const char *name) {
+    dt_timestamp_t ts;
+    size_t i;
+    dt_t dt;
+    int sod;
+
+    memset(dts, 0, sizeof(dts));
+    memset(sods, 0, sizeof(sods));
+    dt_tz_utc_to_local_n(tz, src, n, dts, sods);
+    for (i = 0; i < n; i++) {
+        ts.sec  = dt_tz_utc_to_local(tz, src[i], NULL);
+        ts.nsec = 0;
+        dt_timestamp_to_dt(ts, &dt, &sod, NULL);
+        if (dts[i] != dt || sods[i] != sod) {
+            diag("%s: row %d (%lld) is %d %d, exp %d %d",
+                 name, (int)i, (long long)src[i], dts[i], sods[i], dt, sod);
+            return false;
+        }
+    }
+    return true;
+}
+
+int
+main() {
+    unsigned int state;
+    dt_tz_t *tz;
+    size_t i;
+    bool good;
+
+    tz = dt_tz_parse(buf, build("CET-1CEST,M3.5.0,M10.5.0/3"));
+    if (!tz)
+        BAIL_OUT("dt_tz_parse() failed");
+
+    /* Sorted, every 97 minutes from 2019 on, before and after the epoch */
+    for (i = 0; i < N; i++)
+        src[i] = 1546300800 + (int64_t)i * 97 * 60;
+    ok(check(tz, N, "sorted"), "sorted instants");
+    for (i = 0; i < N; i++)
+        src[i] = -86400 * 3 + (int64_t)i * 61;
+    ok(check(tz, N, "epoch"), "sorted instants around the epoch");
+
+    /* Sorted with runs of repeats and jumps of up to a year */
+    state = 7;
+    src[0] = 0;
+    for (i = 1; i < N; i++) {
+        src[i] = src[i - 1];
+        if ((next_rand(&state) >> 8) % 5 == 0)
+            src[i] += (int64_t)((next_rand(&state) >> 4) % 31536000);
+    }
+    ok(check(tz, N, "repeats"), "sorted instants with repeats and jumps");
+
+    /* Unsorted, from 1970 through 2099 */
+    for (i = 0; i < N; i++)
+        src[i] = (int64_t)((next_rand(&state) >> 4) % 0x0FFFFFFF) * 15;
+    ok(check(tz, N, "unsorted"), "unsorted instants");
+
+    good = true;
+    for (i = 0; good && i < 64; i++) {
+        src[i] = (int64_t)((next_rand(&state) >> 4) % 0x0FFFFFFF) * 15;
+        good = check(tz, i + 1, "short");
+    }
+    ok(good, "every length up to 64");
+
+    dt_tz_utc_to_local_n(tz, src, 64, NULL, sods);
+    dt_tz_utc_to_local_n(tz, src, 64, dts, NULL);
+    dt_tz_utc_to_local_n(tz, src, 0, dts, sods);
+    pass("either output may be NULL");
+    dt_tz_free(tz);
+
+    /* A fixed offset has a single interval */
+    tz = dt_tz_parse(buf, build("<-0330>3:30"));
+    ok(tz && check(tz, N, "fixed"), "fixed offset");
+    dt_tz_free(tz);
+
+    done_testing();
+}
@@ -0,0 +1,63 @@
+#include <string.h>
+#include "util.h"
+
+/* A linear congruential generator, the same sequence on every platform */
+unsigned int
+next_rand(unsigned int *state) {
+    *state = *state * 1103515245 + 12345;
+    return *state;
+}
+
+static unsigned char *
+put32(unsigned char *p, uint32_t v) {
+    p[0] = (unsigned char)(v >> 24);
+    p[1] = (unsigned char)(v >> 16);
+    p[2] = (unsigned char)(v >> 8);
+    p[3] = (unsigned char)v;
+    return p + 4;
+}
+
+static unsigned char *
+put_header(unsigned char *p, size_t timecnt, size_t typecnt, size_t charcnt) {
+    memset(p, 0, 44);
+    memcpy(p, "TZif2", 5);
+    put32(p + 32, (uint32_t)timecnt);
+    put32(p + 36, (uint32_t)typecnt);
+    put32(p + 40, (uint32_t)charcnt);
+    return p + 44;
+}
+
+/*
+ * Writes a version 2 TZif file into dst with an empty version 1 block, n
+ * transitions at times to the types in idx, and the POSIX rule footer.
+ * Returns its size.
+ */
+size_t
+tzif_build(unsigned char *dst, const int64_t *times, const unsigned char *idx,
+           size_t n, const tzif_type_t *types, size_t ntypes,
+           const char *chars, size_t nchars, const char *footer) {
+    unsigned char *p;
+    size_t i;
+
+    p = put_header(dst, 0, 1, 1);
+    memset(p, 0, 7);
+    p = put_header(p + 7, n, ntypes, nchars);
+    for (i = 0; i < n; i++) {
+        p = put32(p, (uint32_t)((uint64_t)times[i] >> 32));
+        p = put32(p, (uint32_t)times[i]);
+    }
+    for (i = 0; i < n; i++)
+        *p++ = idx[i];
+    for (i = 0; i < ntypes; i++) {
+        p = put32(p, (uint32_t)types[i].offset);
+        *p++ = (unsigned char)types[i].dst;
+        *p++ = (unsigned char)types[i].abbr;
+    }
+    memcpy(p, chars, nchars);
+    p += nchars;
+    *p++ = '\n';
+    memcpy(p, footer, strlen(footer));
+    p += strlen(footer);
+    *p++ = '\n';
+    return (size_t)(p - dst);
+}
@@ -0,0 +1,19 @@
+#ifndef __T_UTIL_H__
+#define __T_UTIL_H__
+#include <stddef.h>
+#include <stdint.h>
+
+/* Helpers shared by the tests */
+
+typedef struct {
+    int32_t offset;
+    int     dst;
+    int     abbr;
+} tzif_type_t;
+
+unsigned int    next_rand       (unsigned int *state);
+size_t          tzif_build      (unsigned char *dst, const int64_t *times, const unsigned char *idx,
+                                 size_t n, const tzif_type_t *types, size_t ntypes,
+                                 const char *chars, size_t nchars, const char *footer);
+
+#endif
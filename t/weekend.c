@@ -0,0 +1,150 @@
+#include "dt.h"
+#include "tap.h"
+
+/* Reference implementations, one day at a time */
+
+static bool
+ref_is_weekday(unsigned int mask, dt_t dt) {
+    return !(mask & DT_WEEKEND(dt_dow(dt)));
+}
+
+static dt_t
+ref_next_weekday(unsigned int mask, dt_t dt, bool current) {
+    if (!current)
+        dt++;
+    while (!ref_is_weekday(mask, dt))
+        dt++;
+    return dt;
+}
+
+static dt_t
+ref_prev_weekday(unsigned int mask, dt_t dt, bool current) {
+    if (!current)
+        dt--;
+    while (!ref_is_weekday(mask, dt))
+        dt--;
+    return dt;
+}
+
+static dt_t
+ref_add_weekdays(unsigned int mask, dt_t dt, int delta) {
+    for (; delta > 0; delta--)
+        dt = ref_next_weekday(mask, dt, false);
+    for (; delta < 0; delta++)
+        dt = ref_prev_weekday(mask, dt, false);
+    return dt;
+}
+
+static int
+ref_delta_weekdays(unsigned int mask, dt_t start, dt_t end, bool inclusive) {
+    int delta;
+    dt_t dt;
+
+    if (start > end)
+        return -ref_delta_weekdays(mask, end, start, inclusive);
+    delta = 0;
+    for (dt = start; dt <= end; dt++)
+        delta += ref_is_weekday(mask, dt);
+    if (!inclusive && (ref_is_weekday(mask, start) || ref_is_weekday(mask, end)))
+        delta--;
+    return delta;
+}
+
+static const int deltas[] = {
+    -100, -15, -8, -7, -6, -5, -2, -1, 0, 1, 2, 5, 6, 7, 8, 15, 100,
+};
+
+#define NDELTAS (sizeof(deltas) / sizeof(*deltas))
+
+/*
+ * Compares the table driven functions against the reference for every
+ * day of a four week window, each delta and both directions.
+ */
+static bool
+check_mask(const dt_weekend_t *wk, unsigned int mask) {
+    dt_t dt, from;
+    size_t i;
+    int c;
+
+    from = dt_from_ymd(2013, 12, 30);
+    for (dt = from; dt < from + 28; dt++) {
+        if (dt_weekend_is_weekday(wk, dt) != ref_is_weekday(mask, dt))
+            return false;
+        for (c = 0; c < 2; c++) {
+            if (dt_weekend_next_weekday(wk, dt, c) != ref_next_weekday(mask, dt, c))
+                return false;
+            if (dt_weekend_prev_weekday(wk, dt, c) != ref_prev_weekday(mask, dt, c))
+                return false;
+        }
+        for (i = 0; i < NDELTAS; i++) {
+            if (dt_weekend_add_weekdays(wk, dt, deltas[i]) != ref_add_weekdays(mask, dt, deltas[i]))
+                return false;
+            for (c = 0; c < 2; c++) {
+                if (dt_weekend_delta_weekdays(wk, dt, dt + deltas[i], c) !=
+                    ref_delta_weekdays(mask, dt, dt + deltas[i], c))
+                    return false;
+            }
+        }
+    }
+    return true;
+}
+
+int
+main() {
+    dt_weekend_t wk;
+    dt_t dt, from;
+    unsigned int mask;
+    size_t i;
+    bool good;
+    int c;
+
+    ok(!dt_weekend_init(&wk, DT_WEEKEND_ALL), "dt_weekend_init() rejects DT_WEEKEND_ALL");
+    ok(!dt_weekend_init(&wk, 0x80), "dt_weekend_init() rejects an invalid mask");
+
+    good = true;
+    for (mask = 0; good && mask < DT_WEEKEND_ALL; mask++) {
+        good = dt_weekend_init(&wk, mask) && check_mask(&wk, mask);
+        if (!good)
+            diag("mismatch for mask 0x%02X", mask);
+    }
+    ok(good, "every mask agrees with the reference");
+
+    /* The default mask agrees with the built-in tables */
+    dt_weekend_init(&wk, DT_WEEKEND_DEFAULT);
+    good = true;
+    from = dt_from_ymd(1999, 1, 1);
+    for (dt = from; good && dt < from + 800; dt++) {
+        good = dt_weekend_is_weekday(&wk, dt) == dt_is_weekday(dt);
+        for (c = 0; good && c < 2; c++) {
+            good = dt_weekend_next_weekday(&wk, dt, c) == dt_next_weekday(dt, c)
+                && dt_weekend_prev_weekday(&wk, dt, c) == dt_prev_weekday(dt, c);
+        }
+        for (i = 0; good && i < NDELTAS; i++) {
+            good = dt_weekend_add_weekdays(&wk, dt, deltas[i] * 7) == dt_add_weekdays(dt, deltas[i] * 7)
+                && dt_weekend_delta_weekdays(&wk, dt, dt + deltas[i] * 9, true)
+                   == dt_delta_weekdays(dt, dt + deltas[i] * 9, true)
+                && dt_weekend_delta_weekdays(&wk, dt, dt + deltas[i] * 9, false)
+                   == dt_delta_weekdays(dt, dt + deltas[i] * 9, false);
+        }
+    }
+    ok(good, "DT_WEEKEND_DEFAULT agrees with dt_add_weekdays() and friends");
+
+    /* Friday and Saturday */
+    dt_weekend_init(&wk, DT_WEEKEND(DT_FRIDAY) | DT_WEEKEND(DT_SATURDAY));
+    cmp_ok(wk.days, "==", 5, "friday and saturday: five weekdays");
+    cmp_ok(dt_weekend_next_weekday(&wk, dt_from_ymd(2013, 5, 30), false), "==",
+           dt_from_ymd(2013, 6, 2), "friday and saturday: next weekday after a Thursday");
+    cmp_ok(dt_weekend_add_weekdays(&wk, dt_from_ymd(2013, 5, 31), 10), "==",
+           dt_from_ymd(2013, 6, 13), "friday and saturday: ten weekdays after a Friday");
+    cmp_ok(dt_weekend_delta_weekdays(&wk, dt_from_ymd(2013, 6, 1), dt_from_ymd(2013, 6, 30), true),
+           "==", 21, "friday and saturday: weekdays in June 2013");
+
+    /* Friday only */
+    dt_weekend_init(&wk, DT_WEEKEND(DT_FRIDAY));
+    cmp_ok(dt_weekend_add_weekdays(&wk, dt_from_ymd(2013, 6, 6), -6), "==",
+           dt_from_ymd(2013, 5, 30), "friday only: six weekdays before a Thursday");
+    cmp_ok(dt_weekend_delta_weekdays(&wk, dt_from_ymd(2013, 6, 30), dt_from_ymd(2013, 6, 1), true),
+           "==", -26, "friday only: weekdays in June 2013, reversed");
+
+    done_testing();
+}
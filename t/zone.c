@@ -1,6 +1,61 @@
+#include <ctype.h>
+#include <string.h>
 #include "dt.h"
 #include "tap.h"
 
+static const char *names[] = {
+#define DT_ZONE_ENTRY(enc, offset, name, flags) name,
+#include "dt_zone_entries.h"
+#undef DT_ZONE_ENTRY
+};
+
+static const short offsets[] = {
+#define DT_ZONE_ENTRY(enc, offset, name, flags) offset,
+#include "dt_zone_entries.h"
+#undef DT_ZONE_ENTRY
+};
+
+#define COUNT (sizeof(names) / sizeof(*names))
+
+static bool
+same_name(const char *a, const char *b) {
+    for (; *a && toupper((unsigned char)*a) == toupper((unsigned char)*b); a++, b++)
+        ;
+    return *a == *b;
+}
+
+/* Looks up every entry, and the names one letter away from each entry */
+static bool
+check_entries(void) {
+    const dt_zone_t *zone;
+    char buf[8];
+    size_t i, j, k, len;
+
+    for (i = 0; i < COUNT; i++) {
+        len = strlen(names[i]);
+        if (dt_zone_lookup(names[i], len, &zone) != len
+            || strcmp(dt_zone_name(zone), names[i]) != 0
+            || dt_zone_offset(zone) != offsets[i]) {
+            diag("entry %s", names[i]);
+            return false;
+        }
+        for (j = 0; j < len; j++) {
+            strcpy(buf, names[i]);
+            for (buf[j] = 'A'; buf[j] <= 'Z'; buf[j]++) {
+                zone = NULL;
+                for (k = 0; k < COUNT; k++)
+                    if (same_name(buf, names[k]))
+                        break;
+                if (k == COUNT && dt_zone_lookup(buf, len, &zone) != 0) {
+                    diag("%s is not an entry, found %s", buf, dt_zone_name(zone));
+                    return false;
+                }
+            }
+        }
+    }
+    return true;
+}
+
 int 
 main() {
     const dt_zone_t *zone;
@@ -34,5 +89,7 @@ main() {
         is(dt_zone_name(zone), "YEKST", "name is YEKST");
     }
 
+    ok(check_entries(), "every entry is found and no other names");
+
     done_testing();
 }
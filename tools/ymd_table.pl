@@ -0,0 +1,83 @@
+#!/usr/bin/perl
+#
+# This script generates the table used by dt_core.c and dt_accessor.c when
+# compiled with DT_YMD_TABLE. Each day within the window of years is packed
+# into 32 bits:
+#
+#   bits  0-4   day of the month    (1-31)
+#   bits  5-8   month of the year   (1-12)
+#   bits  9-17  day of the year     (1-366)
+#   bits 18-20  day of the week     (1=Monday to 7=Sunday)
+#   bit  21     leap year
+#   bits 22-31  year - first year   (0-1023)
+#
+# Usage: tools/ymd_table.pl [first year] [last year] > dt_ymd_table.h
+#
+use strict;
+use warnings;
+
+my ($First, $Last) = @ARGV;
+
+$First = 1970 unless defined $First;
+$Last  = 2100 unless defined $Last;
+
+($First =~ /\A[0-9]+\z/ && $Last =~ /\A[0-9]+\z/)
+  or die qq/Usage: $0 [first year] [last year]\n/;
+
+($First >= 1 && $First <= $Last)
+  or die qq/First year must be >= 1 and <= last year\n/;
+
+($Last - $First < 1024)
+  or die qq/The window must not exceed 1024 years\n/;
+
+sub leap_year {
+    my ($y) = @_;
+    return ($y % 4 == 0 && ($y % 100 != 0 || $y % 400 == 0)) ? 1 : 0;
+}
+
+sub rdn {
+    my ($y) = @_;
+    $y--;
+    return 365 * $y + int($y/4) - int($y/100) + int($y/400) + 1;
+}
+
+my @DaysInMonth = (31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31);
+
+my @T;
+my $dow = (rdn($First) - 1) % 7 + 1;
+for my $y ($First..$Last) {
+    my $leap = leap_year($y);
+    my $doy  = 1;
+    for my $m (1..12) {
+        my $dim = $DaysInMonth[$m - 1] + ($m == 2 ? $leap : 0);
+        for my $d (1..$dim) {
+            push @T, ($y - $First) << 22 | $leap << 21 | $dow << 18
+                   | $doy << 9 | $m << 5 | $d;
+            $dow = $dow % 7 + 1;
+            $doy++;
+        }
+    }
+}
+
+printf "/* Automatically generated by tools/ymd_table.pl %d %d */\n", $First, $Last;
+print  "#ifndef __DT_YMD_TABLE_H__\n";
+print  "#define __DT_YMD_TABLE_H__\n";
+print  "#include <inttypes.h>\n\n";
+printf "#define DT_YMD_TABLE_FIRST (%d + DT_EPOCH_OFFSET) /* %.4d-01-01 */\n", rdn($First), $First;
+printf "#define DT_YMD_TABLE_SIZE  %d\n\n", scalar @T;
+print  "#define DT_YMD_TABLE_INDEX(dt) ((uint32_t)(dt) - (uint32_t)DT_YMD_TABLE_FIRST)\n\n";
+printf "#define DT_YMD_ENTRY_YEAR(e)  ((int)((e) >> 22) + %d)\n", $First;
+print  "#define DT_YMD_ENTRY_LEAP(e)  ((int)((e) >> 21) & 1)\n";
+print  "#define DT_YMD_ENTRY_DOW(e)   ((int)((e) >> 18) & 7)\n";
+print  "#define DT_YMD_ENTRY_DOY(e)   ((int)((e) >> 9) & 0x1FF)\n";
+print  "#define DT_YMD_ENTRY_MONTH(e) ((int)((e) >> 5) & 0xF)\n";
+print  "#define DT_YMD_ENTRY_DAY(e)   ((int)(e) & 0x1F)\n\n";
+print  "extern const uint32_t dt_ymd_table[DT_YMD_TABLE_SIZE];\n\n";
+print  "#ifdef DT_YMD_TABLE_DEFINE\n";
+print  "const uint32_t dt_ymd_table[DT_YMD_TABLE_SIZE] = {\n";
+while (@T) {
+    printf "    %s,\n", join ', ', map { sprintf '0x%.8X', $_ } splice(@T, 0, 6);
+}
+print  "};\n";
+print  "#endif\n";
+print  "#endif\n";
@@ -106,8 +106,15 @@ while (<$fh>) {
     $Zone{$encoded} = [$flags, $offset, $name];
 }
 
+my @Encoded = sort { $a <=> $b } keys %Zone;
+
+if (@ARGV && $ARGV[0] eq '--hash') {
+    print_hash();
+    exit;
+}
+
 printf "/* Automatically generated by tools/zone.pl */\n";
-foreach my $encoded (sort { $a <=> $b } keys %Zone) {
+foreach my $encoded (@Encoded) {
     my ($flags, $offset, $name) = @{ $Zone{$encoded} };
     
     if ($flags != 0) {
@@ -124,3 +131,41 @@ foreach my $encoded (sort { $a <=> $b } keys %Zone) {
     printf "DT_ZONE_ENTRY(0x%.8X, %4d, \"%s\", %s)\n",
       $encoded, $offset, $name, $flags;
 }
+
+# Searches for a multiplier that maps every encoding to its own slot of a
+# table with 2^$HashBits slots, using the top bits of a 32-bit product.
+# Each slot holds the index of the entry plus one, or zero if empty.
+sub print_hash {
+    my $HashBits = 12;
+    my $shift    = 32 - $HashBits;
+    my $state    = 0x2545F491;
+
+    for (my $tries = 1; $tries <= 1_000_000; $tries++) {
+        $state ^= ($state << 13) & 0xFFFFFFFF;
+        $state ^= $state >> 17;
+        $state ^= ($state << 5) & 0xFFFFFFFF;
+
+        my $mult = $state | 1;
+        my @slot = (0) x (1 << $HashBits);
+        my $i    = 0;
+
+        foreach my $encoded (@Encoded) {
+            my $h = (($encoded * $mult) & 0xFFFFFFFF) >> $shift;
+            last if $slot[$h];
+            $slot[$h] = ++$i;
+        }
+        next if $i != @Encoded;
+
+        printf "/* Automatically generated by tools/zone.pl --hash */\n";
+        printf "#define DT_ZONE_HASH_MULTIPLIER 0x%.8XU\n", $mult;
+        printf "#define DT_ZONE_HASH_BITS       %d\n", $HashBits;
+        printf "\n";
+        printf "static const unsigned short kZoneSlot[1 << DT_ZONE_HASH_BITS] = {\n";
+        while (my @row = splice @slot, 0, 16) {
+            printf "    %s,\n", join ', ', map { sprintf '%3d', $_ } @row;
+        }
+        printf "};\n";
+        return;
+    }
+    die qq<Could not find a perfect hash multiplier>;
+}